@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkConnectedRegionEdgeThresholdExplicitInstantiation.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkConnectedRegionEdgeThresholdExplicitInstantiation_h
+#define __itkConnectedRegionEdgeThresholdExplicitInstantiation_h
+
+#include "itkImage.h"
+#include "itkRegionEdgeFunction.h"
+#include "itkRegionEdgeTileCache.h"
+
+// Input pixel types, output pixel types and dimensions of the filter
+// compiled once into the ConnectedRegionEdgeThreshold library: an
+// unsigned char mask of common input types in 2D and 3D, and float to
+// float in 1D to 3D, as used by the 1D and 2D examples.
+#define itkConnectedRegionEdgeThresholdForEachFilterTypeMacro(MACRO) \
+  MACRO(unsigned char, unsigned char, 2)  \
+  MACRO(short, unsigned char, 2)          \
+  MACRO(unsigned short, unsigned char, 2) \
+  MACRO(float, unsigned char, 2)          \
+  MACRO(unsigned char, unsigned char, 3)  \
+  MACRO(short, unsigned char, 3)          \
+  MACRO(unsigned short, unsigned char, 3) \
+  MACRO(float, unsigned char, 3)          \
+  MACRO(float, float, 1)                  \
+  MACRO(float, float, 2)                  \
+  MACRO(float, float, 3)
+
+// Input pixel types and dimensions of the above, each listed once, for
+// the classes that only depend on the input: the tile cache, the
+// preprocessing kernels and the buffer grower
+#define itkConnectedRegionEdgeThresholdForEachInputTypeMacro(MACRO) \
+  MACRO(unsigned char, 2)  \
+  MACRO(short, 2)          \
+  MACRO(unsigned short, 2) \
+  MACRO(float, 2)          \
+  MACRO(unsigned char, 3)  \
+  MACRO(short, 3)          \
+  MACRO(unsigned short, 3) \
+  MACRO(float, 3)          \
+  MACRO(float, 1)
+
+// Declare or define (KEYWORD extern template, or template) the
+// instantiations for one input pixel type, output pixel type and
+// dimension
+#define itkConnectedRegionEdgeThresholdFilterInstantiationMacro(KEYWORD, PIXEL, OUTPUT, DIMENSION) \
+  KEYWORD class RegionEdgeFunction< Image< PIXEL, DIMENSION >,                                   \
+                                    Image< OUTPUT, DIMENSION >, double >;                        \
+  KEYWORD class ConnectedRegionEdgeThresholdImageFilter< Image< PIXEL, DIMENSION >,              \
+                                                         Image< OUTPUT, DIMENSION > >;
+
+// Declare or define the instantiations for one input pixel type and
+// dimension
+#define itkConnectedRegionEdgeThresholdInputInstantiationMacro(KEYWORD, PIXEL, DIMENSION) \
+  KEYWORD class RegionEdgePreprocessingKernel< Image< PIXEL, DIMENSION > >;                \
+  KEYWORD class RegionEdgeMedianKernel< Image< PIXEL, DIMENSION > >;                       \
+  KEYWORD class RegionEdgeGaussianKernel< Image< PIXEL, DIMENSION > >;                     \
+  KEYWORD class RegionEdgeRescaleKernel< Image< PIXEL, DIMENSION > >;                      \
+  KEYWORD class RegionEdgeTileCache< Image< PIXEL, DIMENSION > >;                          \
+  KEYWORD class RegionEdgeBufferGrower< PIXEL, DIMENSION >;
+
+// When the library is used, every other translation unit only declares
+// these instantiations and links against the library's copy
+#if defined( ITK_CONNECTED_REGION_EDGE_THRESHOLD_EXPLICIT ) && !defined( ITK_MANUAL_INSTANTIATION )
+#include "itkRegionEdgeMedianKernel.h"
+#include "itkRegionEdgeGaussianKernel.h"
+#include "itkRegionEdgeRescaleKernel.h"
+#include "itkRegionEdgeBufferGrower.h"
+
+#define itkConnectedRegionEdgeThresholdFilterExternMacro(PIXEL, OUTPUT, DIMENSION) \
+  itkConnectedRegionEdgeThresholdFilterInstantiationMacro(extern template, PIXEL, OUTPUT, DIMENSION)
+#define itkConnectedRegionEdgeThresholdInputExternMacro(PIXEL, DIMENSION) \
+  itkConnectedRegionEdgeThresholdInputInstantiationMacro(extern template, PIXEL, DIMENSION)
+
+namespace itk
+{
+itkConnectedRegionEdgeThresholdForEachFilterTypeMacro(itkConnectedRegionEdgeThresholdFilterExternMacro)
+itkConnectedRegionEdgeThresholdForEachInputTypeMacro(itkConnectedRegionEdgeThresholdInputExternMacro)
+} // end namespace itk
+
+#undef itkConnectedRegionEdgeThresholdFilterExternMacro
+#undef itkConnectedRegionEdgeThresholdInputExternMacro
+#endif
+
+#endif
@@ -0,0 +1,33 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkConnectedRegionEdgeThresholdImageFilter.cxx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+
+// Explicit instantiations for the common pixel types and dimensions, see
+// itkConnectedRegionEdgeThresholdExplicitInstantiation.h
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+#include "itkRegionEdgeMedianKernel.h"
+#include "itkRegionEdgeGaussianKernel.h"
+#include "itkRegionEdgeRescaleKernel.h"
+#include "itkRegionEdgeBufferGrower.h"
+
+#define itkConnectedRegionEdgeThresholdFilterDefineMacro(PIXEL, OUTPUT, DIMENSION) \
+  itkConnectedRegionEdgeThresholdFilterInstantiationMacro(template, PIXEL, OUTPUT, DIMENSION)
+#define itkConnectedRegionEdgeThresholdInputDefineMacro(PIXEL, DIMENSION) \
+  itkConnectedRegionEdgeThresholdInputInstantiationMacro(template, PIXEL, DIMENSION)
+
+namespace itk
+{
+itkConnectedRegionEdgeThresholdForEachFilterTypeMacro(itkConnectedRegionEdgeThresholdFilterDefineMacro)
+itkConnectedRegionEdgeThresholdForEachInputTypeMacro(itkConnectedRegionEdgeThresholdInputDefineMacro)
+} // end namespace itk
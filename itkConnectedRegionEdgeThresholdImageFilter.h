@@ -20,6 +20,17 @@
 #include "itkImage.h"
 #include "itkImageToImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkProgressReporter.h"
+#include "itkRegionEdgeStatistics.h"
+#include "itkRegionEdgeBoundary.h"
+#include "itkRegionEdgeBucketQueue.h"
+#include "itkRegionEdgeGrowthRecord.h"
+#include "itkRegionEdgeFunction.h"
+#include "itkRegionEdgePreprocessingKernel.h"
+#include "itkRegionEdgeTileCache.h"
+
+#include <map>
+#include <vector>
 
 namespace itk {
 
@@ -33,6 +44,92 @@ namespace itk {
  * Pixels that lie within (NeighborValue - Lower) and (NeighborValue + Upper), inclusive,
  * will be replaced with the replacement value.
  *
+ * While the region grows, the statistics of the accepted pixels (count,
+ * physical volume, intensity mean/minimum/maximum/variance, centroid and
+ * bounding box) are accumulated and made available through
+ * GetRegionStatistics(), so no separate label statistics pass is needed.
+ *
+ * When GenerateBoundary is on, the surface pixels of the region and the
+ * frontier pixels refused by the edge criterion (with the intensity gap
+ * that refused them) are collected as well, from the evaluations the
+ * growth performs anyway, and made available through GetBoundary().
+ *
+ * The default FloodFillTraversal visits pixels in first in first out
+ * order, so the shape of the region depends on the visit order and the
+ * region can leak early through a weak edge. OrderedTraversal instead
+ * always accepts next the candidate with the smallest intensity
+ * difference to the region neighbor that reached it, using a bucket
+ * queue over the quantized difference. Ordered growth can be stopped
+ * after MaximumNumberOfPixels pixels, leaving the most similar pixels in
+ * the region. The candidates the budget left out are reported among the
+ * boundary rejections with m_OutOfBudget set, so that they are not taken
+ * for edges. A candidate is queued again only when a region neighbor
+ * reaches it with a smaller quantized difference, so each pixel is queued
+ * at most NumberOfBuckets times and usually once. The lowest bucket of
+ * each queued pixel is kept in a map that only holds the pixels waiting
+ * in the queue, so this bookkeeping grows with the front of the region
+ * rather than with the image.
+ *
+ * ParentAwareTraversal tests a candidate only against the region pixel
+ * that reached it, one pixel read instead of the 3^n of the neighborhood
+ * scan done by FloodFillTraversal. A candidate refused by one neighbor
+ * is tested again when another region pixel reaches it, so a pixel joins
+ * the region whenever it is within tolerance of any region neighbor,
+ * whatever the visit order. The region is the one of OrderedTraversal
+ * without a pixel budget, grown in first in first out order; both use
+ * the same RegionEdgeFunction::EvaluateFromParent rule.
+ *
+ * That region is not always the one of FloodFillTraversal, which tests a
+ * pixel once, when it is first reached, against every region pixel of
+ * its 3^n neighborhood at that time. FloodFillTraversal can therefore
+ * accept a pixel through a diagonal region neighbor even with face
+ * connectivity, and never accepts a pixel it refused, even when a region
+ * neighbor within tolerance joins later. On piecewise constant images,
+ * where every step is either within tolerance or not, the regions agree.
+ *
+ * With MultiResolution on, the region is first grown on a copy of the
+ * input shrunk by ShrinkFactor (block averages), with the tolerances
+ * multiplied by ShrinkFactor and CoarseToleranceScale. Interior blocks,
+ * the flat blocks (range within tolerance) of the coarse region whose
+ * neighbors all are in the coarse region, are accepted wholesale; the
+ * exact criterion is evaluated at full resolution from their sides and
+ * from the seeds, wherever the region extends, so the full resolution
+ * front is not limited to the blocks along the coarse boundary. The
+ * result contains the one of OrderedTraversal without a pixel budget and
+ * only exceeds it when an interior block is not connected to the seeds at
+ * full resolution. With RepairMultiResolution on, the growth starts from
+ * the seeds alone and an interior block is only accepted wholesale once
+ * the exact growth enters it, which gives the exact region; the pixels of
+ * the interior blocks it never entered are reported as repaired. The
+ * full resolution growth is always the ordered one, whatever Traversal
+ * is set to. A pixel budget cannot be honored when whole blocks are
+ * accepted at once, so setting MaximumNumberOfPixels together with
+ * MultiResolution throws an exception on update.
+ *
+ * When a PreprocessingKernel is set (for instance a
+ * RegionEdgeMedianKernel, RegionEdgeGaussianKernel or
+ * RegionEdgeRescaleKernel), the edge criterion is evaluated on the
+ * preprocessed values instead of the input values, and Lower and Upper
+ * apply to them. The tolerances are real valued (ToleranceType), so a
+ * fractional tolerance can be used on the rescaled or smoothed values of
+ * an integer image. The kernel is only evaluated at the pixels the growth
+ * reads, once each, and the values are kept in a RegionEdgeTileCache, so
+ * the cost of preprocessing follows the size of the region rather than
+ * the size of the image. The region statistics are still computed from
+ * the input values. Changing the parameters of the kernel updates the
+ * filter. A kernel cannot be combined with MultiResolution, whose block
+ * averages and ranges would need the kernel over the whole image; the
+ * filter throws an exception when both are set.
+ *
+ * When a GrowthRecord is set, every accepted pixel is appended to it so
+ * that another thread can display the region while it grows; see
+ * RegionEdgeAsyncUpdate to run the filter in the background. Every
+ * traversal checks AbortGenerateData every 1024 accepted pixels, however
+ * rarely the progress is reported on a large image.
+ *
+ * To grow directly in a buffer owned by another application, without an
+ * itk::Image or the pipeline, see RegionEdgeBufferGrower.
+ *
  * \ingroup RegionGrowingSegmentation
  */
 template <class TInputImage, class TOutputImage>
@@ -60,6 +157,7 @@ public:
   typedef typename InputImageType::PixelType    InputImagePixelType;
   typedef typename InputImageType::IndexType    IndexType;
   typedef typename InputImageType::SizeType     SizeType;
+  typedef typename InputImageType::OffsetType   OffsetType;
 
   typedef TOutputImage                          OutputImageType;
   typedef typename OutputImageType::Pointer     OutputImagePointer;
@@ -82,25 +180,68 @@ public:
   itkSetMacro(ReplaceValue, OutputImagePixelType);
   itkGetConstMacro(ReplaceValue, OutputImagePixelType);
 
+  /** Real type of Lower and Upper, so that a fractional tolerance is not
+   * truncated to an integer pixel type. */
+  typedef typename NumericTraits<InputImagePixelType>::RealType ToleranceType;
+
   /** Type of DataObjects to use for scalar inputs */
-  typedef SimpleDataObjectDecorator<InputImagePixelType> InputPixelObjectType;
+  typedef SimpleDataObjectDecorator<ToleranceType> InputPixelObjectType;
 
-  /** Set Upper and Lower Threshold inputs as values */
-  virtual void SetUpper( InputImagePixelType );
-  virtual void SetLower( InputImagePixelType );
+  /** Set Upper and Lower Threshold inputs as values. Pixel values convert
+   * implicitly. */
+  virtual void SetUpper( ToleranceType );
+  virtual void SetLower( ToleranceType );
 
   /** Set Threshold inputs that are connected to the pipeline */
   virtual void SetUpperInput( const InputPixelObjectType *);
   virtual void SetLowerInput( const InputPixelObjectType *);
 
   /** Get Upper and Lower Threshold inputs as values */
-  virtual InputImagePixelType GetUpper() const;
-  virtual InputImagePixelType GetLower() const;
+  virtual ToleranceType GetUpper() const;
+  virtual ToleranceType GetLower() const;
 
   /** Get Threshold inputs that are connected to the pipeline */
   virtual InputPixelObjectType * GetUpperInput();
   virtual InputPixelObjectType * GetLowerInput();
 
+  /** Statistics of the grown region, accumulated during GenerateData. */
+  typedef RegionEdgeStatistics<InputImageType>            RegionStatisticsType;
+  typedef SimpleDataObjectDecorator<RegionStatisticsType> RegionStatisticsObjectType;
+
+  /** Get the statistics of the grown region as a value. */
+  const RegionStatisticsType & GetRegionStatistics() const;
+
+  /** Get the statistics of the grown region as the decorated output that
+   * can be connected to the pipeline. */
+  RegionStatisticsObjectType * GetRegionStatisticsOutput();
+  const RegionStatisticsObjectType * GetRegionStatisticsOutput() const;
+
+  /** Sparse boundary of the grown region, produced when GenerateBoundary
+   * is on. */
+  typedef RegionEdgeBoundary<TInputImage::ImageDimension> BoundaryType;
+  typedef SimpleDataObjectDecorator<BoundaryType>         BoundaryObjectType;
+
+  /** Set/Get whether the boundary output is generated. The default is
+   * off, in which case the boundary output is empty. */
+  itkSetMacro(GenerateBoundary, bool);
+  itkGetConstMacro(GenerateBoundary, bool);
+  itkBooleanMacro(GenerateBoundary);
+
+  /** Get the boundary of the grown region as a value. */
+  const BoundaryType & GetBoundary() const;
+
+  /** Get the boundary of the grown region as the decorated output that
+   * can be connected to the pipeline. */
+  BoundaryObjectType * GetBoundaryOutput();
+  const BoundaryObjectType * GetBoundaryOutput() const;
+
+  /** Make a DataObject of the correct type to be used as the specified
+   * output. */
+  typedef ProcessObject::DataObjectPointer              DataObjectPointer;
+  typedef ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
+  using Superclass::MakeOutput;
+  virtual DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx);
+
   /** Image dimension constants */
   itkStaticConstMacro(InputImageDimension, unsigned int,
                       TInputImage::ImageDimension);
@@ -129,6 +270,91 @@ public:
    *  Default is to use FaceConnectivity. */
   typedef enum { FaceConnectivity, FullConnectivity } ConnectivityEnumType;
 
+  /** FloodFillTraversal grows in first in first out order.
+   *  OrderedTraversal grows the most similar candidate first.
+   *  ParentAwareTraversal grows in first in first out order, testing a
+   *  candidate against the region pixel that reached it only.
+   *  Default is FloodFillTraversal. */
+  typedef enum { FloodFillTraversal, OrderedTraversal, ParentAwareTraversal } TraversalEnumType;
+
+  /** Set/Get the order in which the region is grown. */
+  itkSetEnumMacro( Traversal, TraversalEnumType );
+  itkGetEnumMacro( Traversal, TraversalEnumType );
+
+  /** Set/Get the number of priority levels the intensity difference is
+   * quantized into for OrderedTraversal, at most
+   * RegionEdgeBucketQueue::MaximumNumberOfBuckets (65536). The default
+   * is 256. */
+  itkSetClampMacro( NumberOfBuckets, unsigned int, 1,
+                    OrderedQueueType::MaximumNumberOfBuckets );
+  itkGetConstMacro( NumberOfBuckets, unsigned int );
+
+  /** Set/Get the maximum number of pixels in the region, seeds included,
+   * for OrderedTraversal. Zero, the default, means no limit. A limit
+   * cannot be combined with MultiResolution. */
+  itkSetMacro( MaximumNumberOfPixels, SizeValueType );
+  itkGetConstMacro( MaximumNumberOfPixels, SizeValueType );
+
+  /** Set/Get whether the region is grown coarse to fine. The default is
+   * off. */
+  itkSetMacro( MultiResolution, bool );
+  itkGetConstMacro( MultiResolution, bool );
+  itkBooleanMacro( MultiResolution );
+
+  /** Set/Get the size of the blocks averaged into one coarse pixel. The
+   * default is 4. */
+  itkSetClampMacro( ShrinkFactor, unsigned int, 2,
+                    NumericTraits<unsigned int>::max() );
+  itkGetConstMacro( ShrinkFactor, unsigned int );
+
+  /** Set/Get the factor applied to Lower and Upper on the coarse image,
+   * on top of ShrinkFactor. Along a ramp every pixel step of which is
+   * within tolerance, the averages of neighboring blocks differ by up to
+   * ShrinkFactor times the tolerance, so the coarse tolerances are Lower
+   * and Upper times ShrinkFactor times this factor. Smaller values let
+   * fewer blocks be accepted wholesale, which is slower but less often
+   * wrong across step edges. The default is 1. */
+  itkSetMacro( CoarseToleranceScale, double );
+  itkGetConstMacro( CoarseToleranceScale, double );
+
+  /** Set/Get whether the coarse to fine growth is made exact: interior
+   * blocks are only accepted wholesale once the full resolution growth
+   * from the seeds reaches them. The default is off. */
+  itkSetMacro( RepairMultiResolution, bool );
+  itkGetConstMacro( RepairMultiResolution, bool );
+  itkBooleanMacro( RepairMultiResolution );
+
+  /** Number of pixels of interior blocks that the exact growth did not
+   * reach, and that the coarse to fine approximation would have wrongly
+   * accepted. Only computed when RepairMultiResolution is on. */
+  itkGetConstMacro( NumberOfRepairedPixels, SizeValueType );
+
+  /** Per pixel preprocessing evaluated during the growth. */
+  typedef RegionEdgePreprocessingKernel<InputImageType> PreprocessingKernelType;
+
+  /** Set/Get the kernel the edge criterion is evaluated on. The default
+   * is NULL, the input values are used. Not supported together with
+   * MultiResolution. */
+  itkSetObjectMacro( PreprocessingKernel, PreprocessingKernelType );
+  itkGetObjectMacro( PreprocessingKernel, PreprocessingKernelType );
+
+  /** Modification time of the filter, including the one of the
+   * preprocessing kernel. */
+  virtual ModifiedTimeType GetMTime() const;
+
+  /** Number of pixels the preprocessing kernel was evaluated at during
+   * the last run. */
+  itkGetConstMacro( NumberOfPreprocessedPixels, SizeValueType );
+
+  /** Record of the accepted pixels, in acceptance order, that can be read
+   * by another thread while the filter runs. */
+  typedef RegionEdgeGrowthRecord<TInputImage::ImageDimension> GrowthRecordType;
+
+  /** Set/Get the record the accepted pixels are appended to. The default
+   * is NULL, no record. */
+  itkSetObjectMacro( GrowthRecord, GrowthRecordType );
+  itkGetObjectMacro( GrowthRecord, GrowthRecordType );
+
 #ifdef ITK_USE_REVIEW
   /** Type of connectivity to use (fully connected OR 4(2D), 6(3D),
    * 2*N(ND) connectivity) */
@@ -140,8 +366,8 @@ protected:
 	ConnectedRegionEdgeThresholdImageFilter();
 	~ConnectedRegionEdgeThresholdImageFilter(){};
   std::vector<IndexType> m_SeedList;
-  InputImagePixelType    m_Lower;
-  InputImagePixelType    m_Upper;
+  ToleranceType          m_Lower;
+  ToleranceType          m_Upper;
   OutputImagePixelType   m_ReplaceValue;
 
   // Override since the filter needs all the data for the algorithm
@@ -152,9 +378,127 @@ protected:
 
   void GenerateData();
 
+  // Mark a pixel as part of the region and update everything that is
+  // accumulated while growing. Every AbortCheckInterval pixels, publish
+  // the GrowthRecord and throw ProcessAborted if an abort was requested.
+  void AcceptPixel(const InputImageType * input, OutputImageType * output,
+                   const IndexType & index);
+  itkStaticConstMacro(AbortCheckInterval, unsigned int, 1024);
+
+  // Edge criterion evaluated by the traversals
+  typedef RegionEdgeFunction<InputImageType, OutputImageType, double> EdgeFunctionType;
+
+  // Grow from the seeds in first in first out order, testing each
+  // candidate against the region pixel that reached it
+  void GenerateParentAwareData(const InputImageType * input, OutputImageType * output,
+                               const EdgeFunctionType * function, ProgressReporter & progress);
+
+  // Candidate of the ordered traversal: a pixel and its intensity
+  // difference to the region neighbor that queued it
+  struct OrderedCandidateType
+    {
+    IndexType m_Index;
+    double    m_Difference;
+    };
+  typedef RegionEdgeBucketQueue<OrderedCandidateType> OrderedQueueType;
+  typedef std::map<OffsetValueType, unsigned int> QueuedBucketMapType;
+
+  // Front of the ordered traversal. The lowest bucket each waiting pixel
+  // has been queued at is kept by offset in the output buffer, so that it
+  // is only queued again at a lower bucket; the entry is dropped when the
+  // pixel is accepted. Candidates are tested with the EvaluateFromParent
+  // rule of the edge function.
+  struct OrderedFrontType
+    {
+    OrderedQueueType         m_Queue;
+    QueuedBucketMapType      m_QueuedBuckets;
+    double                   m_BucketScale;
+    const EdgeFunctionType * m_Function;
+    };
+
+  // Empty the front
+  void InitializeOrderedFront(OrderedFrontType & front, const EdgeFunctionType * function) const;
+
+  // Grow from the seeds, most similar candidate first
+  void GenerateOrderedData(const InputImageType * input, OutputImageType * output,
+                           const EdgeFunctionType * function, ProgressReporter & progress);
+
+  // Queue the neighbors of a region pixel that pass the edge criterion
+  // against it
+  void QueueOrderedNeighbors(const OutputImageType * output, const IndexType & parent,
+                             const std::vector<OffsetType> & offsets, OrderedFrontType & front);
+
+  // Coarse image and per block classification of the multi-resolution
+  // mode. The coarse growth labels the blocks of the coarse region.
+  // Interior blocks are flat blocks inside the coarse region; they become
+  // accepted once they have been taken into the region wholesale.
+  typedef Image<double, itkGetStaticConstMacro(InputImageDimension)>        CoarseImageType;
+  typedef Image<unsigned char, itkGetStaticConstMacro(InputImageDimension)> BlockImageType;
+  enum { OutsideBlock = 0, InteriorBlock = 1, AcceptedBlock = 2, CoarseRegionBlock = 3 };
+
+  // Accept queued candidates until the queue is empty or the region has
+  // budget pixels (zero for no limit). When blocks is not NULL, reaching
+  // an interior block accepts the whole block.
+  void GrowOrderedQueue(const InputImageType * input, OutputImageType * output,
+                        const std::vector<OffsetType> & offsets, SizeValueType budget,
+                        OrderedFrontType & front, BlockImageType * blocks,
+                        ProgressReporter & progress);
+
+  // Grow coarse to fine
+  void GenerateMultiResolutionData(const InputImageType * input, OutputImageType * output,
+                                   const EdgeFunctionType * function, ProgressReporter & progress);
+
+  // Grow the coarse region; blocks get CoarseRegionBlock when in it
+  void GrowCoarseRegion(const CoarseImageType * coarse, BlockImageType * blocks,
+                        const std::vector<OffsetType> & offsets) const;
+
+  // Accept every pixel of an interior block
+  void AcceptBlock(const InputImageType * input, OutputImageType * output,
+                   const IndexType & block, BlockImageType * blocks,
+                   ProgressReporter & progress);
+
+  // Queue the neighbors of the pixels on the sides of an accepted block
+  void QueueBlockSides(const OutputImageType * output, const IndexType & block,
+                       const std::vector<OffsetType> & offsets, OrderedFrontType & front);
+
+  // Block containing a full resolution index
+  IndexType ComputeBlockIndex(const IndexType & index) const;
+
+  // Full resolution pixels of a block, cropped to the image
+  OutputImageRegionType ComputeBlockRegion(const IndexType & block,
+                                           const OutputImageRegionType & largest) const;
+
+  // Turn the recorded rejections into the final boundary
+  void FinalizeBoundary(const OutputImageType * output);
+
   // Type of connectivity to use.
   ConnectivityEnumType m_Connectivity;
 
+  TraversalEnumType    m_Traversal;
+  unsigned int         m_NumberOfBuckets;
+  SizeValueType        m_MaximumNumberOfPixels;
+
+  bool                 m_MultiResolution;
+  unsigned int         m_ShrinkFactor;
+  double               m_CoarseToleranceScale;
+  bool                 m_RepairMultiResolution;
+  SizeValueType        m_NumberOfRepairedPixels;
+
+  // First pixel of the block grid of the multi-resolution mode
+  IndexType            m_BlockOrigin;
+
+  bool                 m_GenerateBoundary;
+
+  typename GrowthRecordType::Pointer m_GrowthRecord;
+
+  typename PreprocessingKernelType::Pointer   m_PreprocessingKernel;
+  RegionEdgeTileCache<InputImageType>         m_TileCache;
+  SizeValueType                               m_NumberOfPreprocessedPixels;
+
+  // Accumulated while growing
+  RegionStatisticsType m_RegionStatistics;
+  BoundaryType         m_Boundary;
+
 private:
   ConnectedRegionEdgeThresholdImageFilter(const Self&); //purposely not implemented
   void operator=(const Self&); //purposely not implemented
@@ -167,4 +511,6 @@ private:
 #include "itkConnectedRegionEdgeThresholdImageFilter.hxx"
 #endif
 
+#include "itkConnectedRegionEdgeThresholdExplicitInstantiation.h"
+
 #endif
@@ -18,15 +18,19 @@
 #define __itkConnectedRegionEdgeThresholdImageFilter_txx
 
 #include "itkConnectedRegionEdgeThresholdImageFilter.h"
-#include "itkRegionEdgeFunction.h"
 
 #include "itkFloodFilledImageFunctionConditionalIterator.h"
-#include "itkProgressReporter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 #ifdef ITK_USE_REVIEW
 #include "itkShapedFloodFilledImageFunctionConditionalIterator.h"
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <queue>
 #include <stdexcept>
 
 namespace itk
@@ -39,18 +43,49 @@ template <class TInputImage, class TOutputImage>
 ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 ::ConnectedRegionEdgeThresholdImageFilter()
 {
-  m_Lower = NumericTraits<InputImagePixelType>::NonpositiveMin();
-  m_Upper = NumericTraits<InputImagePixelType>::max();
+  m_Lower = static_cast<ToleranceType>(NumericTraits<InputImagePixelType>::NonpositiveMin());
+  m_Upper = static_cast<ToleranceType>(NumericTraits<InputImagePixelType>::max());
   m_ReplaceValue = NumericTraits<OutputImagePixelType>::One;
   this->m_Connectivity = FaceConnectivity;
+  m_Traversal = FloodFillTraversal;
+  m_NumberOfBuckets = 256;
+  m_MaximumNumberOfPixels = 0;
+  m_MultiResolution = false;
+  m_ShrinkFactor = 4;
+  m_CoarseToleranceScale = 1.0;
+  m_RepairMultiResolution = false;
+  m_NumberOfRepairedPixels = 0;
+  m_BlockOrigin.Fill(0);
+  m_GenerateBoundary = false;
+  m_NumberOfPreprocessedPixels = 0;
 
   typename InputPixelObjectType::Pointer lower = InputPixelObjectType::New();
-  lower->Set( NumericTraits< InputImagePixelType >::NonpositiveMin() );
+  lower->Set( static_cast<ToleranceType>( NumericTraits< InputImagePixelType >::NonpositiveMin() ) );
   this->ProcessObject::SetNthInput( 1, lower );
 
   typename InputPixelObjectType::Pointer upper = InputPixelObjectType::New();
-  upper->Set( NumericTraits< InputImagePixelType >::max() );
+  upper->Set( static_cast<ToleranceType>( NumericTraits< InputImagePixelType >::max() ) );
   this->ProcessObject::SetNthInput( 2, upper );
+
+  this->SetNumberOfRequiredOutputs( 3 );
+  this->ProcessObject::SetNthOutput( 1, this->MakeOutput( 1 ) );
+  this->ProcessObject::SetNthOutput( 2, this->MakeOutput( 2 ) );
+}
+
+template <class TInputImage, class TOutputImage>
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::DataObjectPointer
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::MakeOutput(DataObjectPointerArraySizeType idx)
+{
+  if( idx == 1 )
+    {
+    return RegionStatisticsObjectType::New().GetPointer();
+    }
+  if( idx == 2 )
+    {
+    return BoundaryObjectType::New().GetPointer();
+    }
+  return Superclass::MakeOutput( idx );
 }
 
 template <class TInputImage, class TOutputImage>
@@ -92,16 +127,24 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 ::PrintSelf(std::ostream& os, Indent indent) const
 {
   this->Superclass::PrintSelf(os, indent);
-  os << indent << "Upper: "
-     << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_Upper)
-     << std::endl;
-  os << indent << "Lower: "
-     << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_Lower)
-     << std::endl;
+  os << indent << "Upper: " << m_Upper << std::endl;
+  os << indent << "Lower: " << m_Lower << std::endl;
   os << indent << "ReplaceValue: "
      << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(m_ReplaceValue)
      << std::endl;
   os << indent << "Connectivity: " << m_Connectivity << std::endl;
+  os << indent << "Traversal: " << m_Traversal << std::endl;
+  os << indent << "NumberOfBuckets: " << m_NumberOfBuckets << std::endl;
+  os << indent << "MaximumNumberOfPixels: " << m_MaximumNumberOfPixels << std::endl;
+  os << indent << "MultiResolution: " << m_MultiResolution << std::endl;
+  os << indent << "ShrinkFactor: " << m_ShrinkFactor << std::endl;
+  os << indent << "CoarseToleranceScale: " << m_CoarseToleranceScale << std::endl;
+  os << indent << "RepairMultiResolution: " << m_RepairMultiResolution << std::endl;
+  os << indent << "NumberOfRepairedPixels: " << m_NumberOfRepairedPixels << std::endl;
+  os << indent << "GenerateBoundary: " << m_GenerateBoundary << std::endl;
+  os << indent << "GrowthRecord: " << m_GrowthRecord.GetPointer() << std::endl;
+  os << indent << "PreprocessingKernel: " << m_PreprocessingKernel.GetPointer() << std::endl;
+  os << indent << "NumberOfPreprocessedPixels: " << m_NumberOfPreprocessedPixels << std::endl;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -127,6 +170,19 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
   output->SetRequestedRegionToLargestPossibleRegion();
 }
 
+template <class TInputImage, class TOutputImage>
+ModifiedTimeType
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GetMTime() const
+{
+  ModifiedTimeType mtime = Superclass::GetMTime();
+  if(m_PreprocessingKernel)
+    {
+    mtime = std::max(mtime, m_PreprocessingKernel->GetMTime());
+    }
+  return mtime;
+}
+
 template <class TInputImage, class TOutputImage>
 void 
 ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
@@ -157,7 +213,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
 template <class TInputImage, class TOutputImage>
 void
 ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
-::SetUpper(const InputImagePixelType threshold)
+::SetUpper(const ToleranceType threshold)
 {
   // first check to see if anything changed
   typename InputPixelObjectType::Pointer upper=this->GetUpperInput();
@@ -182,7 +238,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 template <class TInputImage, class TOutputImage>
 void
 ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
-::SetLower(const InputImagePixelType threshold)
+::SetLower(const ToleranceType threshold)
 {
   // first check to see if anything changed
   typename InputPixelObjectType::Pointer lower=this->GetLowerInput();
@@ -216,7 +272,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
     // no input object available, create a new one and set it to the
     // default threshold
     lower = InputPixelObjectType::New();
-    lower->Set( NumericTraits<InputImagePixelType>::NonpositiveMin() );
+    lower->Set( static_cast<ToleranceType>( NumericTraits<InputImagePixelType>::NonpositiveMin() ) );
     this->ProcessObject::SetNthInput( 1, lower );
     }
     
@@ -236,7 +292,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
     // no input object available, create a new one and set it to the
     // default threshold
     upper = InputPixelObjectType::New();
-    upper->Set( NumericTraits<InputImagePixelType>::NonpositiveMin() );
+    upper->Set( static_cast<ToleranceType>( NumericTraits<InputImagePixelType>::NonpositiveMin() ) );
     this->ProcessObject::SetNthInput( 2, upper );
     }
     
@@ -245,7 +301,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
 
 
 template <class TInputImage, class TOutputImage>
-typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::InputImagePixelType
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::ToleranceType
 ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 ::GetLower() const
 {
@@ -256,7 +312,7 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 }
 
 template <class TInputImage, class TOutputImage>
-typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::InputImagePixelType
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::ToleranceType
 ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
 ::GetUpper() const
 {
@@ -266,6 +322,626 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
   return upper->Get();
 }
 
+template <class TInputImage, class TOutputImage>
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::RegionStatisticsObjectType *
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetRegionStatisticsOutput()
+{
+  return static_cast<RegionStatisticsObjectType *>( this->ProcessObject::GetOutput(1) );
+}
+
+template <class TInputImage, class TOutputImage>
+const typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::RegionStatisticsObjectType *
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetRegionStatisticsOutput() const
+{
+  return static_cast<const RegionStatisticsObjectType *>( this->ProcessObject::GetOutput(1) );
+}
+
+template <class TInputImage, class TOutputImage>
+const typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::RegionStatisticsType &
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetRegionStatistics() const
+{
+  return this->GetRegionStatisticsOutput()->Get();
+}
+
+template <class TInputImage, class TOutputImage>
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::BoundaryObjectType *
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetBoundaryOutput()
+{
+  return static_cast<BoundaryObjectType *>( this->ProcessObject::GetOutput(2) );
+}
+
+template <class TInputImage, class TOutputImage>
+const typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::BoundaryObjectType *
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetBoundaryOutput() const
+{
+  return static_cast<const BoundaryObjectType *>( this->ProcessObject::GetOutput(2) );
+}
+
+template <class TInputImage, class TOutputImage>
+const typename ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>::BoundaryType &
+ConnectedRegionEdgeThresholdImageFilter<TInputImage, TOutputImage>
+::GetBoundary() const
+{
+  return this->GetBoundaryOutput()->Get();
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::AcceptPixel(const InputImageType * input, OutputImageType * output,
+              const IndexType & index)
+{
+  output->SetPixel(index, m_ReplaceValue);
+  m_RegionStatistics.AddPixel(index, input->GetPixel(index));
+  if(m_GrowthRecord)
+    {
+    m_GrowthRecord->Append(index);
+    }
+
+  if(m_GenerateBoundary)
+    {
+    // Pixels on the image border have neighbors that are never tested,
+    // so they are surface pixels without a rejection to reveal them
+    const OutputImageRegionType & largest = output->GetLargestPossibleRegion();
+    for(unsigned int d = 0; d < OutputImageDimension; ++d)
+      {
+      if(index[d] == largest.GetIndex(d) ||
+         index[d] == largest.GetIndex(d) + static_cast<IndexValueType>(largest.GetSize(d)) - 1)
+        {
+        m_Boundary.GetSurface().push_back(index);
+        break;
+        }
+      }
+    }
+
+  // The progress reporter only looks at the abort flag once per percent
+  // of the image, which can be long after a cancel on a large image
+  if(m_RegionStatistics.GetCount() % AbortCheckInterval == 0)
+    {
+    if(m_GrowthRecord)
+      {
+      m_GrowthRecord->Publish();
+      }
+    if(this->GetAbortGenerateData())
+      {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GenerateParentAwareData(const InputImageType * input, OutputImageType * output,
+                          const EdgeFunctionType * function, ProgressReporter & progress)
+{
+  std::vector<OffsetType> offsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets(offsets, m_Connectivity == FullConnectivity);
+  const OutputImageRegionType & largest = output->GetLargestPossibleRegion();
+
+  // Every pixel in the queue is already in the region. A candidate that
+  // fails against its parent stays out of the region, so it is reached
+  // again, and tested against the new parent, by each of its other
+  // region neighbors.
+  std::queue<IndexType> queue;
+  for(unsigned int i = 0; i < m_SeedList.size(); ++i)
+    {
+    queue.push(m_SeedList[i]);
+    }
+
+  while(!queue.empty())
+    {
+    const IndexType parent = queue.front();
+    queue.pop();
+    const double parentValue = function->GetValue(parent);
+
+    for(unsigned int i = 0; i < offsets.size(); ++i)
+      {
+      const IndexType candidate = parent + offsets[i];
+      if(!largest.IsInside(candidate) ||
+         output->GetPixel(candidate) != NumericTraits<OutputImagePixelType>::Zero)
+        {
+        continue;
+        }
+
+      if(function->EvaluateFromParent(parent, parentValue, offsets[i]))
+        {
+        this->AcceptPixel(input, output, candidate);
+        queue.push(candidate);
+        progress.CompletedPixel();  // potential exception thrown here
+        }
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::InitializeOrderedFront(OrderedFrontType & front, const EdgeFunctionType * function) const
+{
+  front.m_Queue.SetNumberOfBuckets(m_NumberOfBuckets);
+  front.m_Function = function;
+
+  // Map the accepted differences, -Lower to Upper, onto the buckets
+  const double largestDifference = std::max(std::fabs(static_cast<double>(m_Lower)),
+                                            std::fabs(static_cast<double>(m_Upper)));
+  front.m_BucketScale = largestDifference > 0.0 ? (m_NumberOfBuckets - 1) / largestDifference : 0.0;
+
+  front.m_QueuedBuckets.clear();
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GenerateOrderedData(const InputImageType * input, OutputImageType * output,
+                      const EdgeFunctionType * function, ProgressReporter & progress)
+{
+  std::vector<OffsetType> offsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets(offsets, m_Connectivity == FullConnectivity);
+
+  OrderedFrontType front;
+  this->InitializeOrderedFront(front, function);
+
+  for(unsigned int i = 0; i < m_SeedList.size(); ++i)
+    {
+    this->QueueOrderedNeighbors(output, m_SeedList[i], offsets, front);
+    }
+
+  this->GrowOrderedQueue(input, output, offsets, m_MaximumNumberOfPixels, front, 0, progress);
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GrowOrderedQueue(const InputImageType * input, OutputImageType * output,
+                   const std::vector<OffsetType> & offsets, SizeValueType budget,
+                   OrderedFrontType & front, BlockImageType * blocks,
+                   ProgressReporter & progress)
+{
+  // A candidate is queued again only when a region neighbor accepts it at
+  // a lower bucket. It joins the region when first popped, the copies at
+  // higher buckets are skipped. The pixels of an accepted block lose their
+  // queued bucket here too.
+  while(!front.m_Queue.IsEmpty())
+    {
+    const OrderedCandidateType candidate = front.m_Queue.Pop();
+    const OffsetValueType key = output->ComputeOffset(candidate.m_Index);
+    if(output->GetPixel(candidate.m_Index) != NumericTraits<OutputImagePixelType>::Zero)
+      {
+      front.m_QueuedBuckets.erase(key);
+      continue;
+      }
+
+    if(budget > 0 && m_RegionStatistics.GetCount() >= budget)
+      {
+      if(!m_GenerateBoundary)
+        {
+        break;
+        }
+      // Out of budget: the candidate stays on the frontier, flagged so
+      // that it is not taken for an edge
+      typename BoundaryType::RejectionType rejection;
+      rejection.m_Index = candidate.m_Index;
+      rejection.m_Difference = candidate.m_Difference;
+      rejection.m_OutOfBudget = true;
+      m_Boundary.GetRejections().push_back(rejection);
+      continue;
+      }
+
+    front.m_QueuedBuckets.erase(key);
+    this->AcceptPixel(input, output, candidate.m_Index);
+    progress.CompletedPixel();  // potential exception thrown here
+    this->QueueOrderedNeighbors(output, candidate.m_Index, offsets, front);
+
+    if(blocks)
+      {
+      const IndexType block = this->ComputeBlockIndex(candidate.m_Index);
+      if(blocks->GetPixel(block) == InteriorBlock)
+        {
+        this->AcceptBlock(input, output, block, blocks, progress);
+        this->QueueBlockSides(output, block, offsets, front);
+        }
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::QueueOrderedNeighbors(const OutputImageType * output, const IndexType & parent,
+                        const std::vector<OffsetType> & offsets, OrderedFrontType & front)
+{
+  const OutputImageRegionType & largest = output->GetLargestPossibleRegion();
+  const double parentValue = front.m_Function->GetValue(parent);
+
+  for(unsigned int i = 0; i < offsets.size(); ++i)
+    {
+    OrderedCandidateType candidate;
+    candidate.m_Index = parent + offsets[i];
+    if(!largest.IsInside(candidate.m_Index) ||
+       output->GetPixel(candidate.m_Index) != NumericTraits<OutputImagePixelType>::Zero)
+      {
+      continue;
+      }
+
+    // The function records the refusals when GenerateBoundary is on
+    if(!front.m_Function->EvaluateFromParent(parent, parentValue, offsets[i],
+                                             candidate.m_Difference))
+      {
+      continue;
+      }
+
+    const unsigned int bucket = std::min(m_NumberOfBuckets - 1,
+      static_cast<unsigned int>(std::fabs(candidate.m_Difference) * front.m_BucketScale));
+
+    const OffsetValueType key = output->ComputeOffset(candidate.m_Index);
+    typename QueuedBucketMapType::iterator queued = front.m_QueuedBuckets.lower_bound(key);
+    if(queued != front.m_QueuedBuckets.end() && queued->first == key)
+      {
+      if(queued->second <= bucket)
+        {
+        continue;
+        }
+      queued->second = bucket;
+      }
+    else
+      {
+      front.m_QueuedBuckets.insert(queued, std::make_pair(key, bucket));
+      }
+    front.m_Queue.Push(bucket, candidate);
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>::IndexType
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::ComputeBlockIndex(const IndexType & index) const
+{
+  IndexType block;
+  for(unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+    block[d] = (index[d] - m_BlockOrigin[d]) / static_cast<IndexValueType>(m_ShrinkFactor);
+    }
+  return block;
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GrowCoarseRegion(const CoarseImageType * coarse, BlockImageType * blocks,
+                   const std::vector<OffsetType> & offsets) const
+{
+  const typename BlockImageType::RegionType & coarseRegion = blocks->GetLargestPossibleRegion();
+  // A ramp within tolerance at every pixel changes the block averages by
+  // up to ShrinkFactor times the tolerance
+  const double scale = m_CoarseToleranceScale * static_cast<double>(m_ShrinkFactor);
+  const RegionEdgeCriterion criterion(scale * static_cast<double>(m_Lower),
+                                      scale * static_cast<double>(m_Upper));
+
+  // A block that fails against one region neighbor is tested again when
+  // another one reaches it, so the order of the queue does not matter
+  std::queue<IndexType> queue;
+  for(unsigned int i = 0; i < m_SeedList.size(); ++i)
+    {
+    const IndexType block = this->ComputeBlockIndex(m_SeedList[i]);
+    if(blocks->GetPixel(block) == OutsideBlock)
+      {
+      blocks->SetPixel(block, CoarseRegionBlock);
+      queue.push(block);
+      }
+    }
+
+  while(!queue.empty())
+    {
+    const IndexType parent = queue.front();
+    queue.pop();
+    const double parentValue = coarse->GetPixel(parent);
+    for(unsigned int i = 0; i < offsets.size(); ++i)
+      {
+      const IndexType block = parent + offsets[i];
+      if(!coarseRegion.IsInside(block) || blocks->GetPixel(block) != OutsideBlock)
+        {
+        continue;
+        }
+      const double difference = coarse->GetPixel(block) - parentValue;
+      if(criterion.Accepts(difference))
+        {
+        blocks->SetPixel(block, CoarseRegionBlock);
+        queue.push(block);
+        }
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::GenerateMultiResolutionData(const InputImageType * input, OutputImageType * output,
+                              const EdgeFunctionType * function, ProgressReporter & progress)
+{
+  const OutputImageRegionType & largest = output->GetLargestPossibleRegion();
+  const IndexValueType shrink = static_cast<IndexValueType>(m_ShrinkFactor);
+  m_BlockOrigin = largest.GetIndex();
+
+  // Average the input over blocks of ShrinkFactor pixels, and keep the
+  // range of each block
+  typename CoarseImageType::RegionType coarseRegion;
+  typename CoarseImageType::SizeType coarseSize;
+  for(unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+    coarseSize[d] = (largest.GetSize(d) + m_ShrinkFactor - 1) / m_ShrinkFactor;
+    }
+  coarseRegion.SetSize(coarseSize);
+
+  typename CoarseImageType::Pointer coarse = CoarseImageType::New();
+  coarse->SetRegions(coarseRegion);
+  coarse->Allocate();
+  coarse->FillBuffer(0.0);
+
+  typename CoarseImageType::Pointer blockMinimum = CoarseImageType::New();
+  blockMinimum->SetRegions(coarseRegion);
+  blockMinimum->Allocate();
+  blockMinimum->FillBuffer(NumericTraits<double>::max());
+
+  typename CoarseImageType::Pointer blockMaximum = CoarseImageType::New();
+  blockMaximum->SetRegions(coarseRegion);
+  blockMaximum->Allocate();
+  blockMaximum->FillBuffer(NumericTraits<double>::NonpositiveMin());
+
+  ImageRegionConstIteratorWithIndex<InputImageType> inputIt(input, largest);
+  for(inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt)
+    {
+    const IndexType block = this->ComputeBlockIndex(inputIt.GetIndex());
+    const double value = static_cast<double>(inputIt.Get());
+    coarse->GetPixel(block) += value;
+    blockMinimum->GetPixel(block) = std::min(blockMinimum->GetPixel(block), value);
+    blockMaximum->GetPixel(block) = std::max(blockMaximum->GetPixel(block), value);
+    }
+
+  ImageRegionIteratorWithIndex<CoarseImageType> coarseIt(coarse, coarseRegion);
+  for(coarseIt.GoToBegin(); !coarseIt.IsAtEnd(); ++coarseIt)
+    {
+    // Blocks along the far sides may be cut by the image border
+    double blockSize = 1.0;
+    for(unsigned int d = 0; d < InputImageDimension; ++d)
+      {
+      const IndexValueType remaining = static_cast<IndexValueType>(largest.GetSize(d))
+                                     - coarseIt.GetIndex()[d] * shrink;
+      blockSize *= static_cast<double>(std::min(shrink, remaining));
+      }
+    coarseIt.Set(coarseIt.Get() / blockSize);
+    }
+
+  // Grow on the coarse image
+  std::vector<OffsetType> offsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets(offsets, m_Connectivity == FullConnectivity);
+
+  typename BlockImageType::Pointer coarseLabels = BlockImageType::New();
+  coarseLabels->SetRegions(coarseRegion);
+  coarseLabels->Allocate();
+  coarseLabels->FillBuffer(OutsideBlock);
+  this->GrowCoarseRegion(coarse, coarseLabels, offsets);
+  coarse = 0;
+
+  // Region blocks whose neighbors all are in the region, and whose range
+  // passes the criterion both ways, are interior. Every pair of pixels of
+  // such a block passes the criterion, so once one of its pixels is in
+  // the region, all of them are.
+  std::vector<OffsetType> blockOffsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets(blockOffsets, true);
+
+  typename BlockImageType::Pointer blocks = BlockImageType::New();
+  blocks->SetRegions(coarseRegion);
+  blocks->Allocate();
+
+  const RegionEdgeCriterion criterion(m_Lower, m_Upper);
+  ImageRegionIteratorWithIndex<BlockImageType> blockIt(blocks, coarseRegion);
+  for(blockIt.GoToBegin(); !blockIt.IsAtEnd(); ++blockIt)
+    {
+    const IndexType & block = blockIt.GetIndex();
+    const double range = blockMaximum->GetPixel(block) - blockMinimum->GetPixel(block);
+    bool interior = coarseLabels->GetPixel(block) == CoarseRegionBlock &&
+                    criterion.AcceptsRange(range);
+    for(unsigned int i = 0; i < blockOffsets.size() && interior; ++i)
+      {
+      const IndexType neighbor = block + blockOffsets[i];
+      interior = !coarseRegion.IsInside(neighbor) ||
+                 coarseLabels->GetPixel(neighbor) == CoarseRegionBlock;
+      }
+    blockIt.Set(interior ? InteriorBlock : OutsideBlock);
+    }
+  coarseLabels = 0;
+  blockMinimum = 0;
+  blockMaximum = 0;
+
+  OrderedFrontType front;
+  this->InitializeOrderedFront(front, function);
+
+  if(!m_RepairMultiResolution)
+    {
+    // Accept the interior blocks wholesale and grow exactly from their
+    // sides, as far as the criterion lets the region extend. All of them
+    // are accepted before any side is queued, so that no candidate is
+    // queued inside a block about to be accepted anyway.
+    for(blockIt.GoToBegin(); !blockIt.IsAtEnd(); ++blockIt)
+      {
+      if(blockIt.Get() == InteriorBlock)
+        {
+        this->AcceptBlock(input, output, blockIt.GetIndex(), blocks, progress);
+        }
+      }
+    for(blockIt.GoToBegin(); !blockIt.IsAtEnd(); ++blockIt)
+      {
+      if(blockIt.Get() == AcceptedBlock)
+        {
+        this->QueueBlockSides(output, blockIt.GetIndex(), offsets, front);
+        }
+      }
+    }
+  else
+    {
+    // Grow exactly from the seeds, and only accept an interior block
+    // wholesale once the growth reaches it
+    for(unsigned int i = 0; i < m_SeedList.size(); ++i)
+      {
+      const IndexType block = this->ComputeBlockIndex(m_SeedList[i]);
+      if(blocks->GetPixel(block) == InteriorBlock)
+        {
+        this->AcceptBlock(input, output, block, blocks, progress);
+        this->QueueBlockSides(output, block, offsets, front);
+        }
+      }
+    }
+
+  for(unsigned int i = 0; i < m_SeedList.size(); ++i)
+    {
+    this->QueueOrderedNeighbors(output, m_SeedList[i], offsets, front);
+    }
+  this->GrowOrderedQueue(input, output, offsets, 0, front, blocks, progress);
+
+  // The interior blocks the exact growth never entered are those the
+  // approximation would have accepted wrongly
+  if(m_RepairMultiResolution)
+    {
+    for(blockIt.GoToBegin(); !blockIt.IsAtEnd(); ++blockIt)
+      {
+      if(blockIt.Get() == InteriorBlock)
+        {
+        m_NumberOfRepairedPixels +=
+          this->ComputeBlockRegion(blockIt.GetIndex(), largest).GetNumberOfPixels();
+        }
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::AcceptBlock(const InputImageType * input, OutputImageType * output,
+              const IndexType & block, BlockImageType * blocks,
+              ProgressReporter & progress)
+{
+  blocks->SetPixel(block, AcceptedBlock);
+
+  const OutputImageRegionType blockRegion =
+    this->ComputeBlockRegion(block, output->GetLargestPossibleRegion());
+  ImageRegionConstIteratorWithIndex<OutputImageType> pixelIt(output, blockRegion);
+  for(pixelIt.GoToBegin(); !pixelIt.IsAtEnd(); ++pixelIt)
+    {
+    if(pixelIt.Get() == NumericTraits<OutputImagePixelType>::Zero)
+      {
+      this->AcceptPixel(input, output, pixelIt.GetIndex());
+      progress.CompletedPixel();  // potential exception thrown here
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::QueueBlockSides(const OutputImageType * output, const IndexType & block,
+                  const std::vector<OffsetType> & offsets, OrderedFrontType & front)
+{
+  const OutputImageRegionType blockRegion =
+    this->ComputeBlockRegion(block, output->GetLargestPossibleRegion());
+
+  // Only the pixels on the sides of the block have neighbors outside it
+  ImageRegionConstIteratorWithIndex<OutputImageType> pixelIt(output, blockRegion);
+  for(pixelIt.GoToBegin(); !pixelIt.IsAtEnd(); ++pixelIt)
+    {
+    bool onSide = false;
+    for(unsigned int d = 0; d < InputImageDimension && !onSide; ++d)
+      {
+      const IndexValueType position = pixelIt.GetIndex()[d] - blockRegion.GetIndex(d);
+      onSide = position == 0 ||
+               position == static_cast<IndexValueType>(blockRegion.GetSize(d)) - 1;
+      }
+    if(onSide)
+      {
+      this->QueueOrderedNeighbors(output, pixelIt.GetIndex(), offsets, front);
+      }
+    }
+}
+
+template <class TInputImage, class TOutputImage>
+typename ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>::OutputImageRegionType
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::ComputeBlockRegion(const IndexType & block, const OutputImageRegionType & largest) const
+{
+  OutputImageRegionType blockRegion;
+  for(unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+    blockRegion.SetIndex(d, m_BlockOrigin[d] + block[d] * static_cast<IndexValueType>(m_ShrinkFactor));
+    blockRegion.SetSize(d, m_ShrinkFactor);
+    }
+  blockRegion.Crop(largest);
+  return blockRegion;
+}
+
+template <class TInputImage, class TOutputImage>
+void
+ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
+::FinalizeBoundary(const OutputImageType * output)
+{
+  typedef typename BoundaryType::RejectionContainerType RejectionContainerType;
+  typedef typename BoundaryType::IndexContainerType     IndexContainerType;
+
+  const OutputImageRegionType & largest = output->GetLargestPossibleRegion();
+
+  // A pixel can be refused several times before it is accepted or given
+  // up on. Keep the closest refusal of the pixels left outside, or the
+  // budget entry of a pixel the budget left out.
+  RejectionContainerType & rejections = m_Boundary.GetRejections();
+  std::sort(rejections.begin(), rejections.end(),
+            typename BoundaryType::RejectionCompare());
+  RejectionContainerType outside;
+  for(typename RejectionContainerType::const_iterator r = rejections.begin();
+      r != rejections.end(); ++r)
+    {
+    if(!outside.empty() && outside.back().m_Index == r->m_Index)
+      {
+      continue;
+      }
+    if(output->GetPixel(r->m_Index) != NumericTraits<OutputImagePixelType>::Zero)
+      {
+      continue;
+      }
+    outside.push_back(*r);
+    }
+  rejections.swap(outside);
+
+  // Every neighbor of the region that is inside the image has been tested,
+  // so the region pixels next to a rejection form the rest of the surface
+  std::vector<OffsetType> offsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets(offsets, m_Connectivity == FullConnectivity);
+
+  IndexContainerType & surface = m_Boundary.GetSurface();
+  for(typename RejectionContainerType::const_iterator r = rejections.begin();
+      r != rejections.end(); ++r)
+    {
+    for(unsigned int i = 0; i < offsets.size(); ++i)
+      {
+      const IndexType neighbor = r->m_Index + offsets[i];
+      if(largest.IsInside(neighbor) &&
+         output->GetPixel(neighbor) != NumericTraits<OutputImagePixelType>::Zero)
+        {
+        surface.push_back(neighbor);
+        }
+      }
+    }
+  std::sort(surface.begin(), surface.end(),
+            Functor::IndexLexicographicCompare<InputImageDimension>());
+  surface.erase(std::unique(surface.begin(), surface.end()), surface.end());
+}
+
 template <class TInputImage, class TOutputImage>
 void 
 ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
@@ -280,13 +956,26 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
   m_Lower = lowerThreshold->Get();
   m_Upper = upperThreshold->Get();
 
+  // The coarse pass reads every pixel, which a lazily evaluated kernel is
+  // meant to avoid
+  if(m_MultiResolution && m_PreprocessingKernel)
+    {
+    itkExceptionMacro(<< "MultiResolution does not support a PreprocessingKernel");
+    }
+
+  // Whole blocks are accepted at once, past any pixel budget
+  if(m_MultiResolution && m_MaximumNumberOfPixels > 0)
+    {
+    itkExceptionMacro(<< "MultiResolution does not support MaximumNumberOfPixels");
+    }
+
   // Zero the output
   OutputImageRegionType region =  outputImage->GetRequestedRegion();
   outputImage->SetBufferedRegion( region );
   outputImage->Allocate();
   outputImage->FillBuffer ( NumericTraits<OutputImagePixelType>::Zero );
   
-  typedef RegionEdgeFunction<InputImageType, OutputImageType, double> FunctionType;
+  typedef EdgeFunctionType FunctionType;
 
   typename FunctionType::Pointer function = FunctionType::New();
   function->SetInputImage ( inputImage );
@@ -295,6 +984,26 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
 
   ProgressReporter progress(this, 0, region.GetNumberOfPixels());
 
+  // Accumulated as pixels are accepted, so that no statistics or boundary
+  // pass over the output is needed afterwards
+  m_RegionStatistics.Initialize();
+  m_Boundary.Clear();
+  m_NumberOfRepairedPixels = 0;
+  if(m_GenerateBoundary)
+    {
+    function->SetRejectionContainer(&m_Boundary.GetRejections());
+    }
+  if(m_GrowthRecord)
+    {
+    m_GrowthRecord->Initialize();
+    }
+  if(m_PreprocessingKernel)
+    {
+    m_PreprocessingKernel->Initialize(inputImage);
+    m_TileCache.Initialize(inputImage, m_PreprocessingKernel);
+    function->SetTileCache(&m_TileCache);
+    }
+
   // Set the seed pixels to be in the region that is produced
   for(unsigned int i = 0; i < m_SeedList.size(); ++i)
   {
@@ -305,10 +1014,25 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
          << outputImage->GetLargestPossibleRegion() << ")";
       throw std::runtime_error(ss.str());
     }
-    outputImage->SetPixel(m_SeedList[i], m_ReplaceValue);
+    if(outputImage->GetPixel(m_SeedList[i]) != m_ReplaceValue)
+    {
+      this->AcceptPixel(inputImage, outputImage, m_SeedList[i]);
+    }
   }
 
-  if (this->m_Connectivity == FaceConnectivity)
+  if (this->m_MultiResolution)
+    {
+    this->GenerateMultiResolutionData(inputImage, outputImage, function, progress);
+    }
+  else if (this->m_Traversal == OrderedTraversal)
+    {
+    this->GenerateOrderedData(inputImage, outputImage, function, progress);
+    }
+  else if (this->m_Traversal == ParentAwareTraversal)
+    {
+    this->GenerateParentAwareData(inputImage, outputImage, function, progress);
+    }
+  else if (this->m_Connectivity == FaceConnectivity)
     {
     typedef FloodFilledImageFunctionConditionalIterator<OutputImageType, FunctionType> IteratorType;
     IteratorType it ( outputImage, function, m_SeedList );
@@ -316,7 +1040,11 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
     
     while( !it.IsAtEnd())
       {
-      it.Set(m_ReplaceValue);
+      // seeds were already set and counted above
+      if(it.Get() != m_ReplaceValue)
+        {
+        this->AcceptPixel(inputImage, outputImage, it.GetIndex());
+        }
       ++it;
       progress.CompletedPixel();  // potential exception thrown here
       }
@@ -337,13 +1065,34 @@ ConnectedRegionEdgeThresholdImageFilter<TInputImage,TOutputImage>
 
     while( !it.IsAtEnd())
       {
-      it.Set(m_ReplaceValue);
+      // seeds were already set and counted above
+      if(it.Get() != m_ReplaceValue)
+        {
+        this->AcceptPixel(inputImage, outputImage, it.GetIndex());
+        }
       ++it;
       progress.CompletedPixel();  // potential exception thrown here
       }
     }
 #endif
 
+  if(m_GrowthRecord)
+    {
+    m_GrowthRecord->Publish();
+    }
+
+  m_RegionStatistics.Finalize(inputImage);
+  this->GetRegionStatisticsOutput()->Set(m_RegionStatistics);
+
+  if(m_GenerateBoundary)
+    {
+    this->FinalizeBoundary(outputImage);
+    }
+  this->GetBoundaryOutput()->Set(m_Boundary);
+  m_Boundary.Clear();
+
+  m_NumberOfPreprocessedPixels = m_TileCache.GetNumberOfComputedValues();
+  m_TileCache.Clear();
 }
 
 
@@ -0,0 +1,93 @@
+#include "itkImage.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+
+int main( int, char *[])
+{
+  // A pixel inside the 60x60 square of value 100
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+                ConnectedFilterType;
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->GenerateBoundaryOn();
+  connectedThreshold->Update();
+
+  // The surface is the ring of 236 pixels along the edge of the square and
+  // the rejections are the 240 face neighbors around it, all 100 darker
+  const ConnectedFilterType::BoundaryType & boundary =
+    connectedThreshold->GetBoundary();
+  std::cout << boundary << std::endl;
+
+  bool pass = true;
+  if(boundary.GetSurface().size() != 236)
+    {
+    std::cerr << "Wrong number of surface pixels: " << boundary.GetSurface().size() << std::endl;
+    pass = false;
+    }
+  if(boundary.GetRejections().size() != 240)
+    {
+    std::cerr << "Wrong number of rejections: " << boundary.GetRejections().size() << std::endl;
+    pass = false;
+    }
+  for(unsigned int i = 0; i < boundary.GetRejections().size(); ++i)
+    {
+    const ConnectedFilterType::BoundaryType::RejectionType & rejection =
+      boundary.GetRejections()[i];
+    if(rejection.m_Difference != -100.0 || connectedThreshold->GetOutput()->GetPixel(rejection.m_Index) != 0)
+      {
+      std::cerr << "Wrong rejection at " << rejection.m_Index << std::endl;
+      pass = false;
+      }
+    }
+  for(unsigned int i = 0; i < boundary.GetSurface().size(); ++i)
+    {
+    const UnsignedCharImageType::IndexType & index = boundary.GetSurface()[i];
+    if(index[0] != 40 && index[0] != 99 && index[1] != 40 && index[1] != 99)
+      {
+      std::cerr << "Wrong surface pixel " << index << std::endl;
+      pass = false;
+      }
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(0);
+
+  // Make a square
+  for(int r = 40; r < 100; r++)
+    {
+    for(int c = 40; c < 100; c++)
+      {
+      UnsignedCharImageType::IndexType pixelIndex = {{r,c}};
+
+      image->SetPixel(pixelIndex, 100);
+      }
+    }
+}
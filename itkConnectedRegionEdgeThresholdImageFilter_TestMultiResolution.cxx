@@ -0,0 +1,188 @@
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+              ConnectedFilterType;
+
+static void CreateSquareImage(UnsignedCharImageType* const image);
+static void CreateWallImage(UnsignedCharImageType* const image);
+static ConnectedFilterType::Pointer CreateFilter(UnsignedCharImageType* const image);
+static bool CheckCount(ConnectedFilterType* const filter, itk::SizeValueType count,
+                       itk::SizeValueType repaired, const char * name);
+
+int main( int, char *[])
+{
+  bool pass = true;
+
+  // Square not aligned with the blocks. With half the coarse tolerance its
+  // blurred sides stay out of the coarse region, and the full resolution
+  // growth from the interior blocks finds them.
+  UnsignedCharImageType::Pointer square = UnsignedCharImageType::New();
+  CreateSquareImage(square);
+
+  ConnectedFilterType::Pointer approximate = CreateFilter(square);
+  approximate->SetCoarseToleranceScale(0.5);
+  approximate->Update();
+  pass = CheckCount(approximate, 3600, 0, "Approximate square") && pass;
+
+  ConnectedFilterType::Pointer repaired = CreateFilter(square);
+  repaired->SetCoarseToleranceScale(0.5);
+  repaired->RepairMultiResolutionOn();
+  repaired->Update();
+  pass = CheckCount(repaired, 3600, 0, "Repaired square") && pass;
+
+  itk::ImageRegionConstIteratorWithIndex<UnsignedCharImageType>
+    squareIt(repaired->GetOutput(), square->GetLargestPossibleRegion());
+  for(squareIt.GoToBegin(); !squareIt.IsAtEnd(); ++squareIt)
+    {
+    const bool expected = square->GetPixel(squareIt.GetIndex()) == 100;
+    if((squareIt.Get() != 0) != expected)
+      {
+      std::cerr << "Wrong label at " << squareIt.GetIndex() << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  // A one pixel wall barely moves the average of its blocks, so the
+  // coarse region crosses it and the blocks behind it are interior. The
+  // approximation accepts them; the exact growth never reaches them.
+  UnsignedCharImageType::Pointer wall = UnsignedCharImageType::New();
+  CreateWallImage(wall);
+
+  approximate = CreateFilter(wall);
+  approximate->Update();
+  pass = CheckCount(approximate, 200 * 200 - 200, 0, "Approximate wall") && pass;
+
+  repaired = CreateFilter(wall);
+  repaired->RepairMultiResolutionOn();
+  repaired->Update();
+  pass = CheckCount(repaired, 100 * 200, 12 * 25 * 8 * 8, "Repaired wall") && pass;
+
+  ConnectedFilterType::Pointer ordered = CreateFilter(wall);
+  ordered->MultiResolutionOff();
+  ordered->SetTraversal(ConnectedFilterType::OrderedTraversal);
+  ordered->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<UnsignedCharImageType>
+    wallIt(repaired->GetOutput(), wall->GetLargestPossibleRegion());
+  for(wallIt.GoToBegin(); !wallIt.IsAtEnd(); ++wallIt)
+    {
+    if(wallIt.Get() != ordered->GetOutput()->GetPixel(wallIt.GetIndex()))
+      {
+      std::cerr << "Repaired region differs from the ordered one at "
+                << wallIt.GetIndex() << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  // Blocks are accepted wholesale, so a pixel budget is refused
+  ConnectedFilterType::Pointer budgeted = CreateFilter(wall);
+  budgeted->SetMaximumNumberOfPixels(1000);
+  try
+    {
+    budgeted->Update();
+    std::cerr << "MultiResolution with a pixel budget was accepted" << std::endl;
+    pass = false;
+    }
+  catch(itk::ExceptionObject &)
+    {
+    }
+
+  // A later run without MultiResolution repairs nothing
+  repaired->MultiResolutionOff();
+  repaired->Update();
+  if(repaired->GetNumberOfRepairedPixels() != 0)
+    {
+    std::cerr << "Repaired count kept from the previous run" << std::endl;
+    pass = false;
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+ConnectedFilterType::Pointer CreateFilter(UnsignedCharImageType* const image)
+{
+  itk::Index<2> seed = {{50,50}};
+
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->MultiResolutionOn();
+  connectedThreshold->SetShrinkFactor(8);
+  return connectedThreshold;
+}
+
+bool CheckCount(ConnectedFilterType* const filter, itk::SizeValueType count,
+                itk::SizeValueType repaired, const char * name)
+{
+  std::cout << name << ": " << filter->GetRegionStatistics() << std::endl;
+
+  bool pass = true;
+  if(filter->GetRegionStatistics().GetCount() != count)
+    {
+    std::cerr << name << ": wrong count " << filter->GetRegionStatistics().GetCount() << std::endl;
+    pass = false;
+    }
+  if(filter->GetNumberOfRepairedPixels() != repaired)
+    {
+    std::cerr << name << ": repaired " << filter->GetNumberOfRepairedPixels() << " pixels" << std::endl;
+    pass = false;
+    }
+  return pass;
+}
+
+void CreateSquareImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(0);
+
+  // Make a square
+  for(int r = 37; r < 97; r++)
+    {
+    for(int c = 37; c < 97; c++)
+      {
+      UnsignedCharImageType::IndexType pixelIndex = {{r,c}};
+
+      image->SetPixel(pixelIndex, 100);
+      }
+    }
+}
+
+void CreateWallImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(100);
+
+  // Make a wall across the image, inside the blocks of rows 96 to 103
+  for(int c = 0; c < 200; c++)
+    {
+    UnsignedCharImageType::IndexType pixelIndex = {{100,c}};
+
+    image->SetPixel(pixelIndex, 200);
+    }
+}
@@ -0,0 +1,112 @@
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+
+int main( int, char *[])
+{
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+                ConnectedFilterType;
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->SetTraversal(ConnectedFilterType::OrderedTraversal);
+  connectedThreshold->Update();
+
+  // Both halves are within tolerance of each other, so without a budget
+  // the whole image is grown
+  bool pass = true;
+  if(connectedThreshold->GetRegionStatistics().GetCount() != 200 * 200)
+    {
+    std::cerr << "Unlimited ordered growth has "
+              << connectedThreshold->GetRegionStatistics().GetCount() << " pixels" << std::endl;
+    pass = false;
+    }
+
+  // With a budget of half the image, every pixel equal to the seed comes
+  // before any pixel of the brighter half
+  connectedThreshold->SetMaximumNumberOfPixels(100 * 200);
+  connectedThreshold->Update();
+
+  const ConnectedFilterType::RegionStatisticsType & statistics =
+    connectedThreshold->GetRegionStatistics();
+  std::cout << statistics << std::endl;
+  if(statistics.GetCount() != 100 * 200 || statistics.GetMaximum() != 100)
+    {
+    std::cerr << "Budgeted ordered growth did not stop at the edge" << std::endl;
+    pass = false;
+    }
+
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType>
+    it(connectedThreshold->GetOutput(), connectedThreshold->GetOutput()->GetLargestPossibleRegion());
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const bool expected = it.GetIndex()[0] < 100;
+    if((it.Get() != 0) != expected)
+      {
+      std::cerr << "Wrong label at " << it.GetIndex() << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  // The brighter column next to the edge is left out by the budget, not
+  // by the edge criterion
+  connectedThreshold->GenerateBoundaryOn();
+  connectedThreshold->Update();
+
+  const ConnectedFilterType::BoundaryType & boundary = connectedThreshold->GetBoundary();
+  std::cout << boundary << std::endl;
+  if(boundary.GetRejections().size() != 200)
+    {
+    std::cerr << "Wrong number of rejections: " << boundary.GetRejections().size() << std::endl;
+    pass = false;
+    }
+  for(unsigned int i = 0; i < boundary.GetRejections().size(); ++i)
+    {
+    const ConnectedFilterType::BoundaryType::RejectionType & rejection =
+      boundary.GetRejections()[i];
+    if(!rejection.m_OutOfBudget || rejection.m_Difference != 5.0 || rejection.m_Index[0] != 100)
+      {
+      std::cerr << "Wrong budget rejection at " << rejection.m_Index << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Two halves separated by a weak edge of 5
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    it.Set(it.GetIndex()[0] < 100 ? 100 : 105);
+    }
+}
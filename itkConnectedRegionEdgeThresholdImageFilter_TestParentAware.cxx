@@ -0,0 +1,184 @@
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+              ConnectedFilterType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+static void CreateSmallImage(UnsignedCharImageType* const image, const int values[5][5]);
+static ConnectedFilterType::Pointer Grow(UnsignedCharImageType* const image, const itk::Index<2> & seed,
+                                         ConnectedFilterType::TraversalEnumType traversal);
+static bool SameRegion(ConnectedFilterType* const first, ConnectedFilterType* const second);
+static bool CheckCounts(const int values[5][5], const char * name,
+                        itk::SizeValueType floodFillCount, itk::SizeValueType parentAwareCount);
+
+int main( int, char *[])
+{
+  bool pass = true;
+
+  // The parent aware region must be the same as the ordered one, whatever
+  // the visit order
+  itk::Index<2> seed = {{10,10}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  ConnectedFilterType::Pointer ordered = Grow(image, seed, ConnectedFilterType::OrderedTraversal);
+  ConnectedFilterType::Pointer parentAware = Grow(image, seed, ConnectedFilterType::ParentAwareTraversal);
+
+  std::cout << parentAware->GetRegionStatistics() << std::endl;
+  if(!SameRegion(parentAware, ordered))
+    {
+    std::cerr << "Parent aware and ordered regions differ" << std::endl;
+    pass = false;
+    }
+
+  // On a piecewise constant image, every step is within tolerance or far
+  // from it, and the flood fill region is the same too
+  const int steps[5][5] = {
+    { 100, 100, 105, 105, 200 },
+    { 100, 200, 200, 105, 200 },
+    { 110, 110, 200, 105, 105 },
+    { 200, 110, 200, 200, 110 },
+    { 110, 110, 110, 110, 110 } };
+  pass = CheckCounts(steps, "Piecewise constant", 17, 17) && pass;
+
+  // (1,1) is within tolerance of the seed, its diagonal neighbor, but not
+  // of (1,0), its only face neighbor in the region. Flood fill accepts it
+  // through the diagonal.
+  const int diagonal[5][5] = {
+    { 100, 108, 200, 200, 200 },
+    { 200,  95, 200, 200, 200 },
+    { 200, 200, 200, 200, 200 },
+    { 200, 200, 200, 200, 200 },
+    { 200, 200, 200, 200, 200 } };
+  pass = CheckCounts(diagonal, "Diagonal", 3, 2) && pass;
+
+  // (2,0) is first reached from (1,0) and refused. Flood fill never tests
+  // it again; the parent aware traversal accepts it from (2,1), reached
+  // later around the 200.
+  const int retest[5][5] = {
+    { 100, 108,  95, 200, 200 },
+    { 100, 200, 100, 200, 200 },
+    { 100, 100, 100, 200, 200 },
+    { 200, 200, 200, 200, 200 },
+    { 200, 200, 200, 200, 200 } };
+  pass = CheckCounts(retest, "Retest", 7, 8) && pass;
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+ConnectedFilterType::Pointer Grow(UnsignedCharImageType* const image, const itk::Index<2> & seed,
+                                  ConnectedFilterType::TraversalEnumType traversal)
+{
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->SetTraversal(traversal);
+  connectedThreshold->Update();
+  return connectedThreshold;
+}
+
+bool SameRegion(ConnectedFilterType* const first, ConnectedFilterType* const second)
+{
+  itk::ImageRegionConstIterator<UnsignedCharImageType>
+    firstIt(first->GetOutput(), first->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<UnsignedCharImageType>
+    secondIt(second->GetOutput(), second->GetOutput()->GetLargestPossibleRegion());
+  for(; !firstIt.IsAtEnd(); ++firstIt, ++secondIt)
+    {
+    if(firstIt.Get() != secondIt.Get())
+      {
+      return false;
+      }
+    }
+  return first->GetRegionStatistics().GetCount() == second->GetRegionStatistics().GetCount();
+}
+
+bool CheckCounts(const int values[5][5], const char * name,
+                 itk::SizeValueType floodFillCount, itk::SizeValueType parentAwareCount)
+{
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateSmallImage(image, values);
+
+  itk::Index<2> seed = {{0,0}};
+  ConnectedFilterType::Pointer floodFill = Grow(image, seed, ConnectedFilterType::FloodFillTraversal);
+  ConnectedFilterType::Pointer ordered = Grow(image, seed, ConnectedFilterType::OrderedTraversal);
+  ConnectedFilterType::Pointer parentAware = Grow(image, seed, ConnectedFilterType::ParentAwareTraversal);
+
+  bool pass = true;
+  if(floodFill->GetRegionStatistics().GetCount() != floodFillCount)
+    {
+    std::cerr << name << ": flood fill region has "
+              << floodFill->GetRegionStatistics().GetCount() << " pixels" << std::endl;
+    pass = false;
+    }
+  if(parentAware->GetRegionStatistics().GetCount() != parentAwareCount)
+    {
+    std::cerr << name << ": parent aware region has "
+              << parentAware->GetRegionStatistics().GetCount() << " pixels" << std::endl;
+    pass = false;
+    }
+  if(!SameRegion(parentAware, ordered))
+    {
+    std::cerr << name << ": parent aware and ordered regions differ" << std::endl;
+    pass = false;
+    }
+  if(floodFillCount == parentAwareCount && !SameRegion(parentAware, floodFill))
+    {
+    std::cerr << name << ": parent aware and flood fill regions differ" << std::endl;
+    pass = false;
+    }
+  return pass;
+}
+
+void CreateSmallImage(UnsignedCharImageType* const image, const int values[5][5])
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{5,5}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // values[y][x], so that the arrays above read as the image
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    it.Set(static_cast<unsigned char>(values[it.GetIndex()[1]][it.GetIndex()[0]]));
+    }
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{100,100}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Ramps that wrap around, so that many pixels are within tolerance of
+  // some of their region neighbors but not of others
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const int x = it.GetIndex()[0];
+    const int y = it.GetIndex()[1];
+    it.Set(static_cast<unsigned char>((x * 7 + y * 13) % 64 + (x / 25) * 40));
+    }
+}
@@ -0,0 +1,179 @@
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+#include "itkRegionEdgeMedianKernel.h"
+#include "itkRegionEdgeRescaleKernel.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+static void CreateRampImage(UnsignedCharImageType* const image);
+
+int main( int, char *[])
+{
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+                ConnectedFilterType;
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->Update();
+
+  // The noise pixels are refused without preprocessing
+  bool pass = true;
+  const itk::SizeValueType rawCount = connectedThreshold->GetRegionStatistics().GetCount();
+  if(rawCount >= 60 * 60 || connectedThreshold->GetNumberOfPreprocessedPixels() != 0)
+    {
+    std::cerr << "Region without preprocessing has " << rawCount << " pixels" << std::endl;
+    pass = false;
+    }
+
+  // A 3x3 median removes the noise and rounds off the four corners of
+  // the square
+  typedef itk::RegionEdgeMedianKernel<UnsignedCharImageType> MedianKernelType;
+  MedianKernelType::Pointer median = MedianKernelType::New();
+  connectedThreshold->SetPreprocessingKernel(median);
+  connectedThreshold->Update();
+
+  const ConnectedFilterType::RegionStatisticsType & statistics =
+    connectedThreshold->GetRegionStatistics();
+  std::cout << statistics << std::endl;
+  std::cout << "Preprocessed pixels: "
+            << connectedThreshold->GetNumberOfPreprocessedPixels() << std::endl;
+
+  if(statistics.GetCount() != 60 * 60 - 4)
+    {
+    std::cerr << "Region with median preprocessing has " << statistics.GetCount()
+              << " pixels" << std::endl;
+    pass = false;
+    }
+
+  // Statistics are still computed on the input values
+  if(statistics.GetMaximum() != 255)
+    {
+    std::cerr << "Statistics were computed on the preprocessed values" << std::endl;
+    pass = false;
+    }
+
+  // Only the region and the pixels around it are preprocessed
+  if(connectedThreshold->GetNumberOfPreprocessedPixels() < statistics.GetCount() ||
+     connectedThreshold->GetNumberOfPreprocessedPixels() > 2 * statistics.GetCount())
+    {
+    std::cerr << "Preprocessed " << connectedThreshold->GetNumberOfPreprocessedPixels()
+              << " pixels" << std::endl;
+    pass = false;
+    }
+
+  // A change of the kernel alone updates the filter; a median of one
+  // pixel gives back the region without preprocessing
+  MedianKernelType::RadiusType radius;
+  radius.Fill(0);
+  median->SetRadius(radius);
+  connectedThreshold->Update();
+  if(connectedThreshold->GetRegionStatistics().GetCount() != rawCount)
+    {
+    std::cerr << "Changing the kernel did not update the filter" << std::endl;
+    pass = false;
+    }
+
+  // The coarse pass of the multi-resolution mode cannot use a kernel
+  connectedThreshold->MultiResolutionOn();
+  try
+    {
+    connectedThreshold->Update();
+    std::cerr << "MultiResolution with a kernel was accepted" << std::endl;
+    pass = false;
+    }
+  catch(itk::ExceptionObject &)
+    {
+    }
+
+  // Tolerances are not truncated to the pixel type: on values rescaled
+  // to [0,1], a tolerance of 0.02 accepts the steps of 3 of the left half
+  // (0.012) and refuses the edge of 18 (0.071) in the middle
+  UnsignedCharImageType::Pointer ramp = UnsignedCharImageType::New();
+  CreateRampImage(ramp);
+
+  typedef itk::RegionEdgeRescaleKernel<UnsignedCharImageType> RescaleKernelType;
+  RescaleKernelType::Pointer rescale = RescaleKernelType::New();
+  rescale->SetScale(1.0 / 255.0);
+
+  ConnectedFilterType::Pointer rescaled = ConnectedFilterType::New();
+  rescaled->SetLower(0.02);
+  rescaled->SetUpper(0.02);
+  rescaled->SetReplaceValue(255);
+  rescaled->SetInput(ramp);
+  rescaled->SetSeed(seed);
+  rescaled->SetPreprocessingKernel(rescale);
+  rescaled->Update();
+
+  if(rescaled->GetLower() != 0.02 || rescaled->GetRegionStatistics().GetCount() != 100 * 200)
+    {
+    std::cerr << "Region with a fractional tolerance has "
+              << rescaled->GetRegionStatistics().GetCount() << " pixels" << std::endl;
+    pass = false;
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void CreateRampImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Two ramps along x rising by 3 every 4 pixels, the right one starting
+  // 18 above the end of the left one
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const int x = it.GetIndex()[0];
+    it.Set(x < 100 ? 3 * (x / 4) : 90 + 3 * ((x - 100) / 4));
+    }
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // A 60x60 square of 100 on a background of 0, with isolated noise
+  // pixels of 255 inside it
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    const int x = it.GetIndex()[0];
+    const int y = it.GetIndex()[1];
+    if(x < 40 || x >= 100 || y < 40 || y >= 100)
+      {
+      it.Set(0);
+      }
+    else
+      {
+      it.Set((x + 3 * y) % 7 == 0 ? 255 : 100);
+      }
+    }
+}
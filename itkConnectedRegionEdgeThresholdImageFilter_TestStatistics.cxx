@@ -0,0 +1,102 @@
+#include "itkImage.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+
+int main( int, char *[])
+{
+  // A pixel inside the 60x60 square of value 100
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+                ConnectedFilterType;
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->Update();
+
+  const ConnectedFilterType::RegionStatisticsType & statistics =
+    connectedThreshold->GetRegionStatistics();
+  std::cout << statistics << std::endl;
+
+  bool pass = true;
+  if(statistics.GetCount() != 3600)
+    {
+    std::cerr << "Wrong count: " << statistics.GetCount() << std::endl;
+    pass = false;
+    }
+  if(std::fabs(statistics.GetVolume() - 3600.0 * 0.25) > 1e-6)
+    {
+    std::cerr << "Wrong volume: " << statistics.GetVolume() << std::endl;
+    pass = false;
+    }
+  if(statistics.GetMinimum() != 100 || statistics.GetMaximum() != 100 ||
+     std::fabs(statistics.GetMean() - 100.0) > 1e-6 ||
+     std::fabs(statistics.GetVariance()) > 1e-6)
+    {
+    std::cerr << "Wrong intensity statistics" << std::endl;
+    pass = false;
+    }
+
+  UnsignedCharImageType::IndexType expectedStart = {{40,40}};
+  UnsignedCharImageType::SizeType expectedSize = {{60,60}};
+  if(statistics.GetBoundingBox().GetIndex() != expectedStart ||
+     statistics.GetBoundingBox().GetSize() != expectedSize)
+    {
+    std::cerr << "Wrong bounding box: " << statistics.GetBoundingBox() << std::endl;
+    pass = false;
+    }
+
+  // Spacing is 0.5, so the centroid of pixels 40..99 is at 69.5 * 0.5
+  for(unsigned int d = 0; d < 2; ++d)
+    {
+    if(std::fabs(statistics.GetCentroid()[d] - 34.75) > 1e-6)
+      {
+      std::cerr << "Wrong centroid: " << statistics.GetCentroid() << std::endl;
+      pass = false;
+      }
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(0);
+
+  UnsignedCharImageType::SpacingType spacing;
+  spacing.Fill(0.5);
+  image->SetSpacing(spacing);
+
+  // Make a square
+  for(int r = 40; r < 100; r++)
+    {
+    for(int c = 40; c < 100; c++)
+      {
+      UnsignedCharImageType::IndexType pixelIndex = {{r,c}};
+
+      image->SetPixel(pixelIndex, 100);
+      }
+    }
+}
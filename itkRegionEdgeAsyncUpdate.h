@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeAsyncUpdate.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeAsyncUpdate_h
+#define __itkRegionEdgeAsyncUpdate_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreader.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <string>
+
+namespace itk
+{
+
+/** \class RegionEdgeAsyncUpdate
+ * \brief Runs a ConnectedRegionEdgeThresholdImageFilter in the background
+ *
+ * Start() calls Update() on the filter in a separate thread and returns
+ * immediately. The caller can then take snapshots of the region grown so
+ * far with GetSnapshot(), wait for the run with an optional timeout, and
+ * Cancel() it, for example when the user moves the seed.
+ *
+ * Snapshots come from the GrowthRecord of the filter, which is created if
+ * the filter has none. They are consistent views that share the storage
+ * of the record rather than copying the output. They are refreshed every
+ * 1024 accepted pixels and at every progress event of the filter.
+ *
+ * Cancel() uses the abort mechanism of the pipeline: the filter checks it
+ * every 1024 accepted pixels and at its progress updates, stops, and the
+ * run ends in the Cancelled state. The
+ * output of the filter must not be used while a run is in progress.
+ *
+ * Destroying the handle cancels a run in progress and waits for it.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TFilter>
+class ITK_EXPORT RegionEdgeAsyncUpdate : public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgeAsyncUpdate     Self;
+  typedef Object                    Superclass;
+  typedef SmartPointer<Self>        Pointer;
+  typedef SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgeAsyncUpdate, Object);
+
+  typedef TFilter                                     FilterType;
+  typedef typename FilterType::GrowthRecordType       GrowthRecordType;
+  typedef typename GrowthRecordType::Snapshot         SnapshotType;
+
+  /** Idle before the first Start(); Running until the run ends as
+   * Completed, Cancelled or Failed. */
+  typedef enum { Idle, Running, Completed, Cancelled, Failed } StateEnumType;
+
+  /** Start updating the filter in the background. Throws if a run is
+   * already in progress. */
+  void Start( FilterType * filter );
+
+  /** Ask the run in progress to stop. Returns immediately; use Wait() to
+   * know when it has stopped. */
+  void Cancel();
+
+  /** Wait until the run has ended or timeout seconds have passed. A
+   * negative timeout waits without limit. Returns true if the run has
+   * ended. */
+  bool Wait( double timeout );
+
+  /** State of the current run. */
+  StateEnumType GetState() const;
+
+  /** Description of the error that made the run fail. */
+  std::string GetErrorDescription() const;
+
+  /** Region grown so far by the current run. */
+  SnapshotType GetSnapshot() const;
+
+  /** The filter being run. */
+  FilterType * GetFilter() const { return m_Filter.GetPointer(); }
+
+protected:
+  RegionEdgeAsyncUpdate();
+  ~RegionEdgeAsyncUpdate();
+  void PrintSelf(std::ostream& os, Indent indent) const;
+
+private:
+  RegionEdgeAsyncUpdate(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  static ITK_THREAD_RETURN_TYPE ThreadCallback( void * arg );
+
+  // Body of the background thread
+  void Run();
+
+  // Progress observer, called by the background thread
+  void OnProgress();
+
+  void SetState( StateEnumType state, const std::string & description );
+
+  typename FilterType::Pointer       m_Filter;
+  typename GrowthRecordType::Pointer m_GrowthRecord;
+  MultiThreader::Pointer             m_Threader;
+  ThreadIdType                       m_ThreadId;
+  bool                               m_ThreadSpawned;
+  unsigned long                      m_ProgressObserverTag;
+
+  // Shared between the threads, guarded by m_Lock
+  StateEnumType               m_State;
+  bool                        m_CancelRequested;
+  std::string                 m_ErrorDescription;
+  mutable SimpleFastMutexLock m_Lock;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeAsyncUpdate.hxx"
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeAsyncUpdate.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeAsyncUpdate_txx
+#define __itkRegionEdgeAsyncUpdate_txx
+
+#include "itkRegionEdgeAsyncUpdate.h"
+#include "itkCommand.h"
+#include "itkEventObject.h"
+#include "itkMutexLockHolder.h"
+#include "itksys/SystemTools.hxx"
+
+namespace itk
+{
+
+template <class TFilter>
+RegionEdgeAsyncUpdate<TFilter>
+::RegionEdgeAsyncUpdate()
+{
+  m_Threader = MultiThreader::New();
+  m_ThreadId = 0;
+  m_ThreadSpawned = false;
+  m_ProgressObserverTag = 0;
+  m_State = Idle;
+  m_CancelRequested = false;
+}
+
+template <class TFilter>
+RegionEdgeAsyncUpdate<TFilter>
+::~RegionEdgeAsyncUpdate()
+{
+  this->Cancel();
+  this->Wait(-1.0);
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::Start( FilterType * filter )
+{
+  if(this->GetState() == Running)
+    {
+    itkExceptionMacro(<< "A run is already in progress");
+    }
+  if(!filter)
+    {
+    itkExceptionMacro(<< "No filter to run");
+    }
+
+  // Join the thread of the previous run
+  this->Wait(-1.0);
+
+  m_Filter = filter;
+  m_GrowthRecord = filter->GetGrowthRecord();
+  if(!m_GrowthRecord)
+    {
+    m_GrowthRecord = GrowthRecordType::New();
+    filter->SetGrowthRecord(m_GrowthRecord);
+    }
+
+  // Always run the growth again, and do not show the previous run in the
+  // snapshots taken before it starts
+  m_Filter->Modified();
+  m_GrowthRecord->Initialize();
+  m_Filter->AbortGenerateDataOff();
+
+  typedef SimpleMemberCommand<Self> CommandType;
+  typename CommandType::Pointer command = CommandType::New();
+  command->SetCallbackFunction(this, &Self::OnProgress);
+  m_ProgressObserverTag = m_Filter->AddObserver(ProgressEvent(), command);
+
+  {
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  m_CancelRequested = false;
+  m_ErrorDescription.clear();
+  m_State = Running;
+  }
+
+  m_ThreadId = m_Threader->SpawnThread(&Self::ThreadCallback, this);
+  m_ThreadSpawned = true;
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::Cancel()
+{
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  if(m_State != Running)
+    {
+    return;
+    }
+  m_CancelRequested = true;
+  m_Filter->AbortGenerateDataOn();
+}
+
+template <class TFilter>
+bool
+RegionEdgeAsyncUpdate<TFilter>
+::Wait( double timeout )
+{
+  // ITK condition variables cannot wait with a timeout, so poll the state
+  const double start = itksys::SystemTools::GetTime();
+  while(this->GetState() == Running)
+    {
+    if(timeout >= 0.0 && itksys::SystemTools::GetTime() - start >= timeout)
+      {
+      return false;
+      }
+    itksys::SystemTools::Delay(1);
+    }
+
+  if(m_ThreadSpawned)
+    {
+    m_Threader->TerminateThread(m_ThreadId);
+    m_ThreadSpawned = false;
+    m_Filter->RemoveObserver(m_ProgressObserverTag);
+    }
+  return true;
+}
+
+template <class TFilter>
+typename RegionEdgeAsyncUpdate<TFilter>::StateEnumType
+RegionEdgeAsyncUpdate<TFilter>
+::GetState() const
+{
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  return m_State;
+}
+
+template <class TFilter>
+std::string
+RegionEdgeAsyncUpdate<TFilter>
+::GetErrorDescription() const
+{
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  return m_ErrorDescription;
+}
+
+template <class TFilter>
+typename RegionEdgeAsyncUpdate<TFilter>::SnapshotType
+RegionEdgeAsyncUpdate<TFilter>
+::GetSnapshot() const
+{
+  if(!m_GrowthRecord)
+    {
+    return SnapshotType();
+    }
+  return m_GrowthRecord->GetSnapshot();
+}
+
+template <class TFilter>
+ITK_THREAD_RETURN_TYPE
+RegionEdgeAsyncUpdate<TFilter>
+::ThreadCallback( void * arg )
+{
+  MultiThreader::ThreadInfoStruct * info =
+    static_cast<MultiThreader::ThreadInfoStruct *>(arg);
+  static_cast<Self *>(info->UserData)->Run();
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::Run()
+{
+  try
+    {
+    m_Filter->Update();
+    this->SetState(Completed, "");
+    }
+  catch(ProcessAborted &)
+    {
+    // Show everything grown before the abort
+    m_GrowthRecord->Publish();
+    this->SetState(Cancelled, "");
+    }
+  catch(ExceptionObject & e)
+    {
+    this->SetState(Failed, e.GetDescription());
+    }
+  catch(std::exception & e)
+    {
+    this->SetState(Failed, e.what());
+    }
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::OnProgress()
+{
+  m_GrowthRecord->Publish();
+
+  // The pipeline clears the abort flag when the update starts, so a
+  // cancel requested before that would be lost
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  if(m_CancelRequested)
+    {
+    m_Filter->AbortGenerateDataOn();
+    }
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::SetState( StateEnumType state, const std::string & description )
+{
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  m_State = state;
+  m_ErrorDescription = description;
+}
+
+template <class TFilter>
+void
+RegionEdgeAsyncUpdate<TFilter>
+::PrintSelf(std::ostream& os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Filter: " << m_Filter.GetPointer() << std::endl;
+  os << indent << "State: " << static_cast<int>(this->GetState()) << std::endl;
+  os << indent << "ErrorDescription: " << this->GetErrorDescription() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,142 @@
+#include "itkCommand.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+#include "itkRegionEdgeAsyncUpdate.h"
+
+#include <cstdlib>
+#include <iostream>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+              ConnectedFilterType;
+typedef itk::RegionEdgeAsyncUpdate<ConnectedFilterType> AsyncUpdateType;
+
+// Cancels the run from the first progress event of the filter, which is
+// sent when the growth starts, so the cancel cannot come after the end
+class CancelCommand : public itk::Command
+{
+public:
+  typedef CancelCommand             Self;
+  typedef itk::SmartPointer<Self>   Pointer;
+  itkNewMacro(Self);
+
+  void Execute(itk::Object *, const itk::EventObject &)
+    {
+    m_AsyncUpdate->Cancel();
+    }
+  void Execute(const itk::Object *, const itk::EventObject &)
+    {
+    m_AsyncUpdate->Cancel();
+    }
+
+  AsyncUpdateType * m_AsyncUpdate;
+
+protected:
+  CancelCommand() : m_AsyncUpdate(0) {}
+};
+
+static void CreateImage(UnsignedCharImageType* const image);
+
+int main( int, char *[])
+{
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(10);
+  connectedThreshold->SetUpper(10);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+
+  AsyncUpdateType::Pointer asyncUpdate = AsyncUpdateType::New();
+
+  // A run left alone completes, and its last snapshot is the whole region
+  bool pass = true;
+  asyncUpdate->Start(connectedThreshold);
+  if(!asyncUpdate->Wait(-1.0) || asyncUpdate->GetState() != AsyncUpdateType::Completed)
+    {
+    std::cerr << "Run did not complete: " << asyncUpdate->GetErrorDescription() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  AsyncUpdateType::SnapshotType snapshot = asyncUpdate->GetSnapshot();
+  if(snapshot.GetNumberOfPixels() != connectedThreshold->GetRegionStatistics().GetCount())
+    {
+    std::cerr << "Snapshot has " << snapshot.GetNumberOfPixels() << " pixels, the region has "
+              << connectedThreshold->GetRegionStatistics().GetCount() << std::endl;
+    pass = false;
+    }
+  for(itk::SizeValueType i = 0; i < snapshot.GetNumberOfPixels(); ++i)
+    {
+    if(connectedThreshold->GetOutput()->GetPixel(snapshot.GetPixel(i)) != 255)
+      {
+      std::cerr << "Snapshot pixel " << snapshot.GetPixel(i) << " is not in the region" << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  // A run cancelled as it starts stops within the first abort check, and
+  // its snapshot holds part of the region only
+  CancelCommand::Pointer cancel = CancelCommand::New();
+  cancel->m_AsyncUpdate = asyncUpdate;
+  const unsigned long cancelTag = connectedThreshold->AddObserver(itk::ProgressEvent(), cancel);
+
+  asyncUpdate->Start(connectedThreshold);
+  if(!asyncUpdate->Wait(-1.0))
+    {
+    std::cerr << "Cancelled run did not stop" << std::endl;
+    return EXIT_FAILURE;
+    }
+  connectedThreshold->RemoveObserver(cancelTag);
+
+  std::cout << "State after cancel: " << asyncUpdate->GetState() << std::endl;
+  if(asyncUpdate->GetState() != AsyncUpdateType::Cancelled)
+    {
+    std::cerr << "Cancelled run was not cancelled: " << asyncUpdate->GetErrorDescription() << std::endl;
+    pass = false;
+    }
+
+  snapshot = asyncUpdate->GetSnapshot();
+  if(snapshot.GetNumberOfPixels() >= 100 * 100)
+    {
+    std::cerr << "Snapshot after cancel has " << snapshot.GetNumberOfPixels() << " pixels" << std::endl;
+    pass = false;
+    }
+  for(itk::SizeValueType i = 0; i < snapshot.GetNumberOfPixels(); ++i)
+    {
+    const itk::Index<2> & index = snapshot.GetPixel(i);
+    if(index[0] >= 100 || index[1] >= 100)
+      {
+      std::cerr << "Snapshot pixel " << index << " is outside the region" << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,200}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // A 100x100 quadrant of 100 on a background of 200
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    it.Set(it.GetIndex()[0] < 100 && it.GetIndex()[1] < 100 ? 100 : 200);
+    }
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeBoundary.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeBoundary_h
+#define __itkRegionEdgeBoundary_h
+
+#include "itkIndex.h"
+
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeBoundary
+ * \brief Sparse description of the boundary of a grown region
+ *
+ * The surface is the list of region pixels that have at least one
+ * neighbor outside of the region (or outside of the image). The
+ * rejections are the frontier pixels that were tested and refused by the
+ * region edge criterion, each with the intensity difference between the
+ * rejected pixel and the closest valued region neighbor it was tested
+ * against.
+ *
+ * A rejection with m_OutOfBudget set is not an edge: the pixel passed the
+ * criterion but was left out because the growth reached its pixel
+ * budget, and its difference is the (within tolerance) one it was queued
+ * with. Such an entry wins over edge refusals of the same pixel.
+ *
+ * Both lists are sorted lexicographically by index and contain no
+ * duplicates.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <unsigned int VDimension>
+class RegionEdgeBoundary
+{
+public:
+  typedef RegionEdgeBoundary Self;
+  typedef Index<VDimension>  IndexType;
+
+  /** A rejected frontier pixel and the intensity gap that caused it. */
+  struct RejectionType
+    {
+    IndexType m_Index;
+    double    m_Difference;
+    bool      m_OutOfBudget;
+
+    RejectionType() : m_Difference( 0.0 ), m_OutOfBudget( false )
+      {
+      }
+
+    bool operator==( const RejectionType & other ) const
+      {
+      return m_Index == other.m_Index && m_Difference == other.m_Difference &&
+             m_OutOfBudget == other.m_OutOfBudget;
+      }
+    };
+
+  /** Orders rejections by index, out of budget first, then the closest
+   * difference first. */
+  struct RejectionCompare
+    {
+    bool operator()( const RejectionType & a, const RejectionType & b ) const
+      {
+      Functor::IndexLexicographicCompare<VDimension> compare;
+      if( compare( a.m_Index, b.m_Index ) )
+        {
+        return true;
+        }
+      if( compare( b.m_Index, a.m_Index ) )
+        {
+        return false;
+        }
+      if( a.m_OutOfBudget != b.m_OutOfBudget )
+        {
+        return a.m_OutOfBudget;
+        }
+      return std::fabs( a.m_Difference ) < std::fabs( b.m_Difference );
+      }
+    };
+
+  typedef std::vector<IndexType>     IndexContainerType;
+  typedef std::vector<RejectionType> RejectionContainerType;
+
+  /** Region pixels that touch the outside of the region. */
+  IndexContainerType & GetSurface() { return m_Surface; }
+  const IndexContainerType & GetSurface() const { return m_Surface; }
+
+  /** Frontier pixels refused by the region edge criterion, or left out
+   * by the pixel budget. */
+  RejectionContainerType & GetRejections() { return m_Rejections; }
+  const RejectionContainerType & GetRejections() const { return m_Rejections; }
+
+  void Clear()
+    {
+    m_Surface.clear();
+    m_Rejections.clear();
+    }
+
+  bool operator==( const Self & other ) const
+    {
+    return m_Surface == other.m_Surface && m_Rejections == other.m_Rejections;
+    }
+  bool operator!=( const Self & other ) const { return !( *this == other ); }
+
+private:
+  IndexContainerType     m_Surface;
+  RejectionContainerType m_Rejections;
+};
+
+template <unsigned int VDimension>
+std::ostream & operator<<( std::ostream & os, const RegionEdgeBoundary<VDimension> & boundary )
+{
+  os << "Surface pixels: " << boundary.GetSurface().size()
+     << " Rejected pixels: " << boundary.GetRejections().size();
+  return os;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeBucketQueue.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeBucketQueue_h
+#define __itkRegionEdgeBucketQueue_h
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeBucketQueue
+ * \brief Priority queue over a small range of integer priorities
+ *
+ * Elements are pushed into the bucket of their (already quantized)
+ * priority and popped lowest bucket first, first in first out within a
+ * bucket. Push is O(1) and Pop is O(1) amortized over the number of
+ * buckets, which makes the queue much cheaper than a binary heap when
+ * the priority range is small.
+ *
+ * Buckets are vectors read from a moving head so that their storage is
+ * reused for the whole run instead of being allocated per element.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TElement>
+class RegionEdgeBucketQueue
+{
+public:
+  typedef TElement ElementType;
+
+  /** Largest number of buckets. Each bucket costs two vectors, so a huge
+   * count would allocate for nothing: no difference range needs more
+   * levels than this. */
+  enum { MaximumNumberOfBuckets = 65536 };
+
+  RegionEdgeBucketQueue()
+    {
+    this->SetNumberOfBuckets( 1 );
+    }
+
+  /** Set the number of priorities, clamped to 1 to
+   * MaximumNumberOfBuckets. This empties the queue. */
+  void SetNumberOfBuckets( unsigned int numberOfBuckets )
+    {
+    if( numberOfBuckets < 1 )
+      {
+      numberOfBuckets = 1;
+      }
+    if( numberOfBuckets > MaximumNumberOfBuckets )
+      {
+      numberOfBuckets = MaximumNumberOfBuckets;
+      }
+    m_Buckets.clear();
+    m_Buckets.resize( numberOfBuckets );
+    m_Heads.assign( numberOfBuckets, 0 );
+    m_Lowest = numberOfBuckets;
+    m_Size = 0;
+    }
+
+  unsigned int GetNumberOfBuckets() const
+    {
+    return static_cast<unsigned int>( m_Buckets.size() );
+    }
+
+  /** Add an element with priority bucket, which must be smaller than the
+   * number of buckets. */
+  void Push( unsigned int bucket, const ElementType & element )
+    {
+    m_Buckets[bucket].push_back( element );
+    if( bucket < m_Lowest )
+      {
+      m_Lowest = bucket;
+      }
+    ++m_Size;
+    }
+
+  /** Remove and return the oldest element of the lowest bucket. The queue
+   * must not be empty. */
+  ElementType Pop()
+    {
+    while( m_Heads[m_Lowest] == m_Buckets[m_Lowest].size() )
+      {
+      ++m_Lowest;
+      }
+
+    std::vector<ElementType> & bucket = m_Buckets[m_Lowest];
+    const ElementType element = bucket[m_Heads[m_Lowest]++];
+    if( m_Heads[m_Lowest] == bucket.size() )
+      {
+      // Keep the capacity for the next elements of this priority
+      bucket.clear();
+      m_Heads[m_Lowest] = 0;
+      }
+    --m_Size;
+    return element;
+    }
+
+  bool IsEmpty() const
+    {
+    return m_Size == 0;
+    }
+
+  size_t GetSize() const
+    {
+    return m_Size;
+    }
+
+private:
+  std::vector< std::vector<ElementType> > m_Buckets;
+  std::vector<size_t>                     m_Heads;
+  unsigned int                            m_Lowest;
+  size_t                                  m_Size;
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeBufferGrower.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeBufferGrower_h
+#define __itkRegionEdgeBufferGrower_h
+
+#include "itkIndex.h"
+#include "itkOffset.h"
+#include "itkSize.h"
+#include "itkRegionEdgeCriterion.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeBufferGrower
+ * \brief Region edge growing directly on a caller owned pixel buffer
+ *
+ * RegionEdgeBufferGrower grows the same region as
+ * ConnectedRegionEdgeThresholdImageFilter with OrderedTraversal and no
+ * pixel budget, or with ParentAwareTraversal: a pixel joins the region when it lies within
+ * (NeighborValue - Lower) and (NeighborValue + Upper), inclusive, of a
+ * neighbor already in the region. It works on a plain pointer, size and
+ * strides, so buffers owned by another application (aligned, padded or
+ * memory mapped) are used in place, without wrapping them in an
+ * itk::Image and without the overhead of the pipeline.
+ *
+ * The result is either written into a caller owned mask buffer, which
+ * must be zero over the image on entry, or returned as runs of region
+ * pixels along the first dimension.
+ *
+ * Strides are in bytes. When no strides are given the buffer is taken to
+ * be contiguous with the first dimension varying fastest, as in
+ * itk::Image.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TPixel, unsigned int VDimension>
+class RegionEdgeBufferGrower
+{
+public:
+  typedef RegionEdgeBufferGrower Self;
+
+  typedef TPixel                PixelType;
+  typedef unsigned char         MaskPixelType;
+  typedef Index<VDimension>     IndexType;
+  typedef Offset<VDimension>    OffsetType;
+  typedef Size<VDimension>      SizeType;
+  typedef std::vector<IndexType> SeedContainerType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, VDimension);
+
+  /** Region pixels m_Start, m_Start + 1, ..., m_Start + m_Length - 1
+   * along the first dimension. */
+  struct RunType
+    {
+    IndexType     m_Start;
+    SizeValueType m_Length;
+    };
+  typedef std::vector<RunType> RunContainerType;
+
+  RegionEdgeBufferGrower();
+
+  /** Set the pixels to grow in. The buffer is not copied and must stay
+   * valid until the growth is done. strides may be NULL for a contiguous
+   * buffer. */
+  void SetInput( const PixelType * buffer, const SizeType & size,
+                 const OffsetValueType * strides = 0 );
+
+  const SizeType & GetSize() const { return m_Size; }
+
+  /** Set/Get the tolerances below and above the neighbor values. As in
+   * the filter, the defaults are the NonpositiveMin and the max of the
+   * pixel type. */
+  void SetLower( PixelType lower ) { m_Lower = lower; }
+  PixelType GetLower() const { return m_Lower; }
+  void SetUpper( PixelType upper ) { m_Upper = upper; }
+  PixelType GetUpper() const { return m_Upper; }
+
+  /** Use the 3^n-1 neighbors instead of the 2*n face neighbors. The
+   * default is face connectivity. */
+  void SetFullyConnected( bool fullyConnected ) { m_FullyConnected = fullyConnected; }
+  bool GetFullyConnected() const { return m_FullyConnected; }
+
+  /** Seeds, which must lie inside the image. */
+  void SetSeed( const IndexType & seed );
+  void AddSeed( const IndexType & seed );
+  void ClearSeeds() { m_Seeds.clear(); }
+  const SeedContainerType & GetSeeds() const { return m_Seeds; }
+
+  /** Grow into mask, setting region pixels to replaceValue, which must
+   * not be zero. The mask must be zero over the image on entry;
+   * maskStrides may be NULL for a contiguous mask. Throws
+   * std::runtime_error, before writing to the mask, when replaceValue is
+   * zero or a seed is outside the image. Returns the number of region
+   * pixels. */
+  SizeValueType GrowIntoMask( MaskPixelType * mask, const OffsetValueType * maskStrides = 0,
+                              MaskPixelType replaceValue = 1 ) const;
+
+  /** Grow and return the region as runs, ordered by their start index
+   * with the last dimension varying slowest. Returns the number of region
+   * pixels. */
+  SizeValueType GrowIntoRuns( RunContainerType & runs ) const;
+
+private:
+  // Region membership kept in the caller's mask
+  class MaskMembership;
+
+  // Region membership kept in a bit per pixel, with the list of
+  // accepted pixels to build the runs from
+  class BitMembership;
+
+  template <class TMembership>
+  SizeValueType Grow( TMembership & membership ) const;
+
+  const PixelType & GetPixel( const IndexType & index ) const;
+
+  // Position of a pixel in a buffer with the given strides
+  static OffsetValueType ComputeOffset( const IndexType & index,
+                                        const OffsetValueType * strides );
+
+  // Strides of a contiguous buffer of elements of the given size
+  void ComputeContiguousStrides( OffsetValueType * strides, OffsetValueType elementSize ) const;
+
+  const char *      m_Buffer;
+  SizeType          m_Size;
+  OffsetValueType   m_Strides[VDimension];
+  PixelType         m_Lower;
+  PixelType         m_Upper;
+  bool              m_FullyConnected;
+  SeedContainerType m_Seeds;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeBufferGrower.hxx"
+#endif
+
+#endif
@@ -0,0 +1,313 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeBufferGrower.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeBufferGrower_txx
+#define __itkRegionEdgeBufferGrower_txx
+
+#include "itkRegionEdgeBufferGrower.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+namespace itk
+{
+
+template <class TPixel, unsigned int VDimension>
+class RegionEdgeBufferGrower<TPixel, VDimension>::MaskMembership
+{
+public:
+  MaskMembership( MaskPixelType * mask, const OffsetValueType * strides,
+                  MaskPixelType replaceValue ) :
+    m_Mask( mask ), m_Strides( strides ), m_ReplaceValue( replaceValue )
+    {
+    }
+
+  bool Contains( const IndexType & index ) const
+    {
+    return m_Mask[Self::ComputeOffset( index, m_Strides )] != 0;
+    }
+
+  void Insert( const IndexType & index )
+    {
+    m_Mask[Self::ComputeOffset( index, m_Strides )] = m_ReplaceValue;
+    }
+
+private:
+  MaskPixelType *         m_Mask;
+  const OffsetValueType * m_Strides;
+  MaskPixelType           m_ReplaceValue;
+};
+
+template <class TPixel, unsigned int VDimension>
+class RegionEdgeBufferGrower<TPixel, VDimension>::BitMembership
+{
+public:
+  explicit BitMembership( const SizeType & size )
+    {
+    SizeValueType numberOfPixels = 1;
+    for( unsigned int d = 0; d < VDimension; ++d )
+      {
+      m_Strides[d] = static_cast<OffsetValueType>( numberOfPixels );
+      numberOfPixels *= size[d];
+      }
+    m_Bits.assign( numberOfPixels, false );
+    }
+
+  bool Contains( const IndexType & index ) const
+    {
+    return m_Bits[Self::ComputeOffset( index, m_Strides )];
+    }
+
+  void Insert( const IndexType & index )
+    {
+    const OffsetValueType offset = Self::ComputeOffset( index, m_Strides );
+    m_Bits[offset] = true;
+    m_Accepted.push_back( offset );
+    }
+
+  /** Contiguous offsets of the region pixels, in acceptance order. */
+  std::vector<OffsetValueType> & GetAccepted() { return m_Accepted; }
+
+private:
+  OffsetValueType              m_Strides[VDimension];
+  std::vector<bool>            m_Bits;
+  std::vector<OffsetValueType> m_Accepted;
+};
+
+template <class TPixel, unsigned int VDimension>
+RegionEdgeBufferGrower<TPixel, VDimension>
+::RegionEdgeBufferGrower()
+{
+  m_Buffer = 0;
+  m_Size.Fill( 0 );
+  for( unsigned int d = 0; d < VDimension; ++d )
+    {
+    m_Strides[d] = 0;
+    }
+  m_Lower = NumericTraits<PixelType>::NonpositiveMin();
+  m_Upper = NumericTraits<PixelType>::max();
+  m_FullyConnected = false;
+}
+
+template <class TPixel, unsigned int VDimension>
+void
+RegionEdgeBufferGrower<TPixel, VDimension>
+::SetInput( const PixelType * buffer, const SizeType & size,
+            const OffsetValueType * strides )
+{
+  m_Buffer = reinterpret_cast<const char *>( buffer );
+  m_Size = size;
+  if( strides )
+    {
+    std::copy( strides, strides + VDimension, m_Strides );
+    }
+  else
+    {
+    this->ComputeContiguousStrides( m_Strides, sizeof( PixelType ) );
+    }
+}
+
+template <class TPixel, unsigned int VDimension>
+void
+RegionEdgeBufferGrower<TPixel, VDimension>
+::SetSeed( const IndexType & seed )
+{
+  this->ClearSeeds();
+  this->AddSeed( seed );
+}
+
+template <class TPixel, unsigned int VDimension>
+void
+RegionEdgeBufferGrower<TPixel, VDimension>
+::AddSeed( const IndexType & seed )
+{
+  m_Seeds.push_back( seed );
+}
+
+template <class TPixel, unsigned int VDimension>
+SizeValueType
+RegionEdgeBufferGrower<TPixel, VDimension>
+::GrowIntoMask( MaskPixelType * mask, const OffsetValueType * maskStrides,
+                MaskPixelType replaceValue ) const
+{
+  // Zero marks the pixels outside the region, so a region labeled zero
+  // would never be seen as grown
+  if( replaceValue == NumericTraits<MaskPixelType>::Zero )
+    {
+    throw std::runtime_error( "The replace value of the mask must not be zero" );
+    }
+
+  OffsetValueType contiguousStrides[VDimension];
+  if( !maskStrides )
+    {
+    this->ComputeContiguousStrides( contiguousStrides, sizeof( MaskPixelType ) );
+    maskStrides = contiguousStrides;
+    }
+
+  MaskMembership membership( mask, maskStrides, replaceValue );
+  return this->Grow( membership );
+}
+
+template <class TPixel, unsigned int VDimension>
+SizeValueType
+RegionEdgeBufferGrower<TPixel, VDimension>
+::GrowIntoRuns( RunContainerType & runs ) const
+{
+  BitMembership membership( m_Size );
+  const SizeValueType count = this->Grow( membership );
+
+  // Contiguous offsets sort in run order; a run ends at a gap or at the
+  // end of a row
+  std::vector<OffsetValueType> & accepted = membership.GetAccepted();
+  std::sort( accepted.begin(), accepted.end() );
+
+  runs.clear();
+  const OffsetValueType rowLength = static_cast<OffsetValueType>( m_Size[0] );
+  for( typename std::vector<OffsetValueType>::const_iterator it = accepted.begin();
+       it != accepted.end(); ++it )
+    {
+    if( !runs.empty() && *it == *( it - 1 ) + 1 && *it % rowLength != 0 )
+      {
+      ++runs.back().m_Length;
+      continue;
+      }
+
+    RunType run;
+    OffsetValueType remainder = *it;
+    for( unsigned int d = 0; d < VDimension; ++d )
+      {
+      run.m_Start[d] = remainder % static_cast<OffsetValueType>( m_Size[d] );
+      remainder /= static_cast<OffsetValueType>( m_Size[d] );
+      }
+    run.m_Length = 1;
+    runs.push_back( run );
+    }
+
+  return count;
+}
+
+template <class TPixel, unsigned int VDimension>
+template <class TMembership>
+SizeValueType
+RegionEdgeBufferGrower<TPixel, VDimension>
+::Grow( TMembership & membership ) const
+{
+  std::vector<OffsetType> offsets;
+  RegionEdgeCriterion::ComputeNeighborOffsets( offsets, m_FullyConnected );
+
+  const RegionEdgeCriterion criterion( m_Lower, m_Upper );
+
+  // Check every seed before the first one is written, so that a bad
+  // seed leaves the mask untouched
+  for( unsigned int i = 0; i < m_Seeds.size(); ++i )
+    {
+    for( unsigned int d = 0; d < VDimension; ++d )
+      {
+      if( m_Seeds[i][d] < 0 || m_Seeds[i][d] >= static_cast<IndexValueType>( m_Size[d] ) )
+        {
+        std::stringstream ss;
+        ss << "Pixel " << m_Seeds[i] << " is not inside the image (" << m_Size << ")";
+        throw std::runtime_error( ss.str() );
+        }
+      }
+    }
+
+  SizeValueType count = 0;
+  std::queue<IndexType> queue;
+  for( unsigned int i = 0; i < m_Seeds.size(); ++i )
+    {
+    if( !membership.Contains( m_Seeds[i] ) )
+      {
+      membership.Insert( m_Seeds[i] );
+      ++count;
+      queue.push( m_Seeds[i] );
+      }
+    }
+
+  // A pixel joins the region as soon as it is within tolerance of the
+  // region neighbor that reaches it. One that fails is tested again when
+  // another region neighbor reaches it, so the visit order does not
+  // change the region.
+  while( !queue.empty() )
+    {
+    const IndexType parent = queue.front();
+    queue.pop();
+    const double parentValue = static_cast<double>( this->GetPixel( parent ) );
+
+    for( unsigned int i = 0; i < offsets.size(); ++i )
+      {
+      const IndexType candidate = parent + offsets[i];
+      bool inside = true;
+      for( unsigned int d = 0; d < VDimension && inside; ++d )
+        {
+        inside = candidate[d] >= 0 && candidate[d] < static_cast<IndexValueType>( m_Size[d] );
+        }
+      if( !inside || membership.Contains( candidate ) )
+        {
+        continue;
+        }
+
+      const double difference = static_cast<double>( this->GetPixel( candidate ) ) - parentValue;
+      if( criterion.Accepts( difference ) )
+        {
+        membership.Insert( candidate );
+        ++count;
+        queue.push( candidate );
+        }
+      }
+    }
+
+  return count;
+}
+
+template <class TPixel, unsigned int VDimension>
+const typename RegionEdgeBufferGrower<TPixel, VDimension>::PixelType &
+RegionEdgeBufferGrower<TPixel, VDimension>
+::GetPixel( const IndexType & index ) const
+{
+  return *reinterpret_cast<const PixelType *>( m_Buffer + ComputeOffset( index, m_Strides ) );
+}
+
+template <class TPixel, unsigned int VDimension>
+OffsetValueType
+RegionEdgeBufferGrower<TPixel, VDimension>
+::ComputeOffset( const IndexType & index, const OffsetValueType * strides )
+{
+  OffsetValueType offset = 0;
+  for( unsigned int d = 0; d < VDimension; ++d )
+    {
+    offset += index[d] * strides[d];
+    }
+  return offset;
+}
+
+template <class TPixel, unsigned int VDimension>
+void
+RegionEdgeBufferGrower<TPixel, VDimension>
+::ComputeContiguousStrides( OffsetValueType * strides, OffsetValueType elementSize ) const
+{
+  OffsetValueType stride = elementSize;
+  for( unsigned int d = 0; d < VDimension; ++d )
+    {
+    strides[d] = stride;
+    stride *= static_cast<OffsetValueType>( m_Size[d] );
+    }
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,170 @@
+#include "itkImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include "itkConnectedRegionEdgeThresholdImageFilter.h"
+#include "itkRegionEdgeBufferGrower.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+typedef itk::Image<unsigned char, 2>  UnsignedCharImageType;
+
+typedef itk::ConnectedRegionEdgeThresholdImageFilter < UnsignedCharImageType, UnsignedCharImageType>
+              ConnectedFilterType;
+
+static void CreateImage(UnsignedCharImageType* const image);
+static ConnectedFilterType::Pointer Grow(UnsignedCharImageType* const image, const itk::Index<2> & seed,
+                                         ConnectedFilterType::TraversalEnumType traversal);
+
+int main( int, char *[])
+{
+  itk::Index<2> seed = {{50,50}};
+
+  UnsignedCharImageType::Pointer image = UnsignedCharImageType::New();
+  CreateImage(image);
+
+  // References: the filter grown in both order independent modes, which
+  // test a candidate against the region pixel that reached it, as the
+  // grower does
+  ConnectedFilterType::Pointer ordered = Grow(image, seed, ConnectedFilterType::OrderedTraversal);
+  ConnectedFilterType::Pointer parentAware = Grow(image, seed, ConnectedFilterType::ParentAwareTraversal);
+
+  // The same pixels in a buffer whose rows are padded to 256 bytes
+  const UnsignedCharImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  const itk::OffsetValueType pitch = 256;
+  std::vector<unsigned char> padded(pitch * size[1], 0);
+  itk::ImageRegionConstIteratorWithIndex<UnsignedCharImageType>
+    inputIt(image, image->GetLargestPossibleRegion());
+  for(inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt)
+    {
+    padded[inputIt.GetIndex()[1] * pitch + inputIt.GetIndex()[0]] = inputIt.Get();
+    }
+
+  typedef itk::RegionEdgeBufferGrower<unsigned char, 2> GrowerType;
+  GrowerType grower;
+
+  // The default tolerances are those of the filter
+  bool pass = true;
+  ConnectedFilterType::Pointer defaults = ConnectedFilterType::New();
+  if(grower.GetLower() != defaults->GetLower() || grower.GetUpper() != defaults->GetUpper())
+    {
+    std::cerr << "Default tolerances differ from the filter" << std::endl;
+    pass = false;
+    }
+
+  const itk::OffsetValueType strides[2] = { 1, pitch };
+  grower.SetInput(&padded[0], size, strides);
+  grower.SetLower(3);
+  grower.SetUpper(4);
+  grower.SetSeed(seed);
+
+  std::vector<unsigned char> mask(size[0] * size[1], 0);
+  const itk::SizeValueType maskCount = grower.GrowIntoMask(&mask[0], 0, 255);
+
+  GrowerType::RunContainerType runs;
+  const itk::SizeValueType runCount = grower.GrowIntoRuns(runs);
+
+  std::vector<unsigned char> runMask(size[0] * size[1], 0);
+  for(unsigned int i = 0; i < runs.size(); ++i)
+    {
+    for(itk::SizeValueType j = 0; j < runs[i].m_Length; ++j)
+      {
+      runMask[runs[i].m_Start[1] * size[0] + runs[i].m_Start[0] + j] = 255;
+      }
+    }
+
+  std::cout << "Region: " << maskCount << " pixels, " << runs.size() << " runs" << std::endl;
+
+  if(maskCount != ordered->GetRegionStatistics().GetCount() ||
+     maskCount != parentAware->GetRegionStatistics().GetCount() || runCount != maskCount)
+    {
+    std::cerr << "Counts differ: ordered " << ordered->GetRegionStatistics().GetCount()
+              << " parent aware " << parentAware->GetRegionStatistics().GetCount()
+              << " mask " << maskCount << " runs " << runCount << std::endl;
+    pass = false;
+    }
+
+  itk::ImageRegionConstIteratorWithIndex<UnsignedCharImageType>
+    outputIt(ordered->GetOutput(), image->GetLargestPossibleRegion());
+  for(outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
+    {
+    const itk::OffsetValueType offset = outputIt.GetIndex()[1] * size[0] + outputIt.GetIndex()[0];
+    if(outputIt.Get() != mask[offset] || outputIt.Get() != runMask[offset] ||
+       parentAware->GetOutput()->GetPixel(outputIt.GetIndex()) != mask[offset])
+      {
+      std::cerr << "Labels differ at " << outputIt.GetIndex() << std::endl;
+      pass = false;
+      break;
+      }
+    }
+
+  // A zero replace value, or a seed outside the image after a valid one,
+  // is refused without touching the mask
+  std::vector<unsigned char> untouched(size[0] * size[1], 0);
+  try
+    {
+    grower.GrowIntoMask(&untouched[0], 0, 0);
+    std::cerr << "Zero replace value accepted" << std::endl;
+    pass = false;
+    }
+  catch(std::runtime_error &)
+    {
+    }
+
+  itk::Index<2> outside = {{-1,0}};
+  grower.AddSeed(outside);
+  try
+    {
+    grower.GrowIntoMask(&untouched[0], 0, 255);
+    std::cerr << "Seed outside the image accepted" << std::endl;
+    pass = false;
+    }
+  catch(std::runtime_error &)
+    {
+    }
+  if(std::count(untouched.begin(), untouched.end(), 0) != static_cast<std::ptrdiff_t>(untouched.size()))
+    {
+    std::cerr << "Refused growth wrote into the mask" << std::endl;
+    pass = false;
+    }
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+ConnectedFilterType::Pointer Grow(UnsignedCharImageType* const image, const itk::Index<2> & seed,
+                                  ConnectedFilterType::TraversalEnumType traversal)
+{
+  ConnectedFilterType::Pointer connectedThreshold = ConnectedFilterType::New();
+  connectedThreshold->SetLower(3);
+  connectedThreshold->SetUpper(4);
+  connectedThreshold->SetReplaceValue(255);
+  connectedThreshold->SetInput(image);
+  connectedThreshold->SetSeed(seed);
+  connectedThreshold->SetTraversal(traversal);
+  connectedThreshold->Update();
+  return connectedThreshold;
+}
+
+void CreateImage(UnsignedCharImageType* const image)
+{
+  UnsignedCharImageType::IndexType corner = {{0,0}};
+
+  UnsignedCharImageType::SizeType size = {{200,150}};
+
+  UnsignedCharImageType::RegionType region(corner, size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  // A texture with both small and large steps between neighbors
+  itk::ImageRegionIteratorWithIndex<UnsignedCharImageType> it(image, region);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    it.Set((it.GetIndex()[0] * 7 + it.GetIndex()[1] * 3 + it.GetIndex()[0] * it.GetIndex()[1] / 40) % 50);
+    }
+}
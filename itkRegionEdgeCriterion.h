@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeCriterion.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeCriterion_h
+#define __itkRegionEdgeCriterion_h
+
+#include "itkOffset.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeCriterion
+ * \brief Edge criterion between a candidate pixel and a region neighbor
+ *
+ * A candidate passes against a neighbor already in the region when its
+ * value lies within (NeighborValue - Lower) and (NeighborValue + Upper),
+ * inclusive, that is when the difference candidate minus neighbor lies
+ * within -Lower and Upper. Values are compared as double whatever the
+ * pixel type.
+ *
+ * This is the single definition of the criterion and of the neighbors it
+ * is tested against, shared by RegionEdgeFunction,
+ * ConnectedRegionEdgeThresholdImageFilter and RegionEdgeBufferGrower.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+class RegionEdgeCriterion
+{
+public:
+  RegionEdgeCriterion( double lower, double upper ) :
+    m_Lower( lower ), m_Upper( upper )
+    {
+    }
+
+  double GetLower() const { return m_Lower; }
+  double GetUpper() const { return m_Upper; }
+
+  /** Whether a candidate whose value minus the value of the region
+   * neighbor is difference passes. */
+  bool Accepts( double difference ) const
+    {
+    return difference >= -m_Lower && difference <= m_Upper;
+    }
+
+  /** Whether any two values at most range apart pass both ways. */
+  bool AcceptsRange( double range ) const
+    {
+    return this->Accepts( range ) && this->Accepts( -range );
+    }
+
+  /** Offsets of the 2*n face neighbors or, when fullyConnected, of the
+   * 3^n-1 neighbors sharing at least a corner. */
+  template <unsigned int VDimension>
+  static void ComputeNeighborOffsets( std::vector< Offset<VDimension> > & offsets,
+                                      bool fullyConnected )
+    {
+    offsets.clear();
+    Offset<VDimension> offset;
+    if( !fullyConnected )
+      {
+      for( unsigned int d = 0; d < VDimension; ++d )
+        {
+        offset.Fill( 0 );
+        offset[d] = -1;
+        offsets.push_back( offset );
+        offset[d] = 1;
+        offsets.push_back( offset );
+        }
+      return;
+      }
+
+    // Every combination of -1, 0, 1 except the center
+    unsigned int numberOfOffsets = 1;
+    for( unsigned int d = 0; d < VDimension; ++d )
+      {
+      numberOfOffsets *= 3;
+      }
+    for( unsigned int n = 0; n < numberOfOffsets; ++n )
+      {
+      unsigned int code = n;
+      bool center = true;
+      for( unsigned int d = 0; d < VDimension; ++d )
+        {
+        offset[d] = static_cast<OffsetValueType>( code % 3 ) - 1;
+        center = center && offset[d] == 0;
+        code /= 3;
+        }
+      if( !center )
+        {
+        offsets.push_back( offset );
+        }
+      }
+    }
+
+private:
+  double m_Lower;
+  double m_Upper;
+};
+
+} // end namespace itk
+
+#endif
@@ -19,6 +19,9 @@
 
 #include "itkImageFunction.h"
 #include "itkConstNeighborhoodIterator.h"
+#include "itkRegionEdgeBoundary.h"
+#include "itkRegionEdgeCriterion.h"
+#include "itkRegionEdgeTileCache.h"
 
 namespace itk
 {
@@ -36,6 +39,13 @@ namespace itk
  * respectively evaluate the function at an geometric point, image index
  * and continuous image index.
  *
+ * When a rejection container is set, every index for which the function
+ * returns false is appended to it, together with the difference between
+ * its value and the closest valued neighbor already in the region.
+ *
+ * When a tile cache is set, the criterion is evaluated on the
+ * preprocessed values it returns instead of the pixels of the image.
+ *
  * \ingroup ImageFunctions
  *
  */
@@ -65,6 +75,10 @@ public:
   /** Typedef to describe the type of pixel. */
   typedef typename TInputImage::PixelType PixelType;
 
+  /** Real type of the tolerances, so that they are not truncated to the
+   * pixel type. */
+  typedef typename NumericTraits<PixelType>::RealType ToleranceType;
+
   /** Dimension underlying input image. */
   itkStaticConstMacro(ImageDimension, unsigned int,Superclass::ImageDimension);
 
@@ -77,6 +91,17 @@ public:
   /** ContinuousIndex typedef support. */
   typedef typename Superclass::ContinuousIndexType ContinuousIndexType;
 
+  /** Offset typedef support. */
+  typedef typename InputImageType::OffsetType OffsetType;
+
+  /** Container receiving the rejected indices. */
+  typedef RegionEdgeBoundary<itkGetStaticConstMacro(ImageDimension)> BoundaryType;
+  typedef typename BoundaryType::RejectionType                      RejectionType;
+  typedef typename BoundaryType::RejectionContainerType             RejectionContainerType;
+
+  /** Source of the preprocessed values. */
+  typedef RegionEdgeTileCache<InputImageType> TileCacheType;
+
   /** Test RegionEdge criteria the image at a point position
    *
    * Returns true if the image intensity at the specified point position
@@ -125,20 +150,62 @@ public:
    * calling the method. */
   virtual bool EvaluateAtIndex( const IndexType & index ) const;
 
+  /** Test RegionEdge criteria of the pixel at parent + offset against the
+   * single region pixel that reached it, the parent, whose value
+   * (preprocessed when a tile cache is set) is given.
+   *
+   * Unlike EvaluateAtIndex, no other neighbor is read, so the test costs
+   * one pixel read instead of 3^n. A pixel refused by one parent must be
+   * tested again when another region pixel reaches it. The pixel is
+   * assumed to lie within the image buffer. */
+  bool EvaluateFromParent( const IndexType & parent, double parentValue,
+                           const OffsetType & offset ) const
+    {
+    double difference;
+    return this->EvaluateFromParent( parent, parentValue, offset, difference );
+    }
+
+  /** As above, also returning the difference between the value of the
+   * pixel and parentValue. */
+  bool EvaluateFromParent( const IndexType & parent, double parentValue,
+                           const OffsetType & offset, double & difference ) const;
+
+  /** Set the container that records rejected indices. The function does
+   * not own it; set to NULL (the default) to stop recording. */
+  void SetRejectionContainer( RejectionContainerType * container )
+    {
+    m_RejectionContainer = container;
+    }
+
+  /** Set the cache the preprocessed values are read from. The function
+   * does not own it; set to NULL (the default) to use the image values. */
+  void SetTileCache( TileCacheType * cache )
+    {
+    m_TileCache = cache;
+    }
+
+  /** Value the criterion is evaluated on at index: the preprocessed value
+   * when a tile cache is set, the image value otherwise. */
+  double GetValue( const IndexType & index ) const
+    {
+    return m_TileCache ? m_TileCache->GetValue(index)
+                       : static_cast<double>(this->GetInputImage()->GetPixel(index));
+    }
+
   /** Get the lower threshold value. */
-  itkGetConstReferenceMacro(Lower,PixelType);
+  itkGetConstReferenceMacro(Lower,ToleranceType);
 
   /** Get the upper threshold value. */
-  itkGetConstReferenceMacro(Upper,PixelType);
+  itkGetConstReferenceMacro(Upper,ToleranceType);
 
   /** Values greater than or equal to the value are inside. */
-  void ThresholdAbove(PixelType thresh);
+  void ThresholdAbove(ToleranceType thresh);
 
   /** Values less than or equal to the value are inside. */
-  void ThresholdBelow(PixelType thresh);
+  void ThresholdBelow(ToleranceType thresh);
 
   /** Values that lie between lower and upper inclusive are inside. */
-  void ThresholdBetween(PixelType lower, PixelType upper);
+  void ThresholdBetween(ToleranceType lower, ToleranceType upper);
 
 protected:
 	RegionEdgeFunction();
@@ -149,28 +216,18 @@ private:
 	RegionEdgeFunction( const Self& ); //purposely not implemented
   void operator=( const Self& ); //purposely not implemented
 
-  PixelType m_Lower;
-  PixelType m_Upper;
+  ToleranceType m_Lower;
+  ToleranceType m_Upper;
   OutputImagePointer OutputImage;
   mutable unsigned int RegionSize;
+  RejectionContainerType * m_RejectionContainer;
+  TileCacheType *          m_TileCache;
 };
 
 } // end namespace itk
 
-
-// Define instantiation macro for this template.
-#define ITK_TEMPLATE_RegionEdgeFunction(_, EXPORT, x, y) namespace itk { \
-  _(2(class EXPORT RegionEdgeFunction< ITK_TEMPLATE_2 x >)) \
-  namespace Templates { typedef RegionEdgeFunction< ITK_TEMPLATE_2 x > \
-                               RegionEdgeFunction##y; } \
-  }
-
-#if ITK_TEMPLATE_EXPLICIT
-# include "Templates/itkRegionEdgeFunction+-.h"
-#endif
-
-#if ITK_TEMPLATE_TXX
-# include "itkRegionEdgeFunction.hxx"
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeFunction.hxx"
 #endif
 
 #endif
@@ -19,6 +19,8 @@
 
 #include "itkRegionEdgeFunction.h"
 
+#include <cmath>
+
 namespace itk
 {
 
@@ -29,6 +31,8 @@ template <class TInputImage, class TOutputImageType, class TCoordRep>
   m_Lower = NumericTraits<PixelType>::NonpositiveMin();
   m_Upper = NumericTraits<PixelType>::max();
   RegionSize = 0;
+  m_RejectionContainer = 0;
+  m_TileCache = 0;
 }
 
 /**
@@ -37,7 +41,7 @@ template <class TInputImage, class TOutputImageType, class TCoordRep>
 template <class TInputImage, class TOutputImageType, class TCoordRep>
 void 
 		RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
-::ThresholdAbove(PixelType thresh)
+::ThresholdAbove(ToleranceType thresh)
 {
   if (m_Lower != thresh
       || m_Upper != NumericTraits<PixelType>::max())
@@ -54,7 +58,7 @@ void
 template <class TInputImage, class TOutputImageType, class TCoordRep>
 void 
 		RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
-::ThresholdBelow(PixelType thresh)
+::ThresholdBelow(ToleranceType thresh)
 {
   if (m_Lower != NumericTraits<PixelType>::NonpositiveMin()
       || m_Upper != thresh)
@@ -71,7 +75,7 @@ void
 template <class TInputImage, class TOutputImageType, class TCoordRep>
 void 
 RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
-::ThresholdBetween(PixelType lower, PixelType upper)
+::ThresholdBetween(ToleranceType lower, ToleranceType upper)
 {
   if (m_Lower != lower
       || m_Upper != upper)
@@ -98,7 +102,8 @@ bool
 RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
 ::EvaluateAtIndex( const IndexType & index ) const
 {
-  PixelType currentPixelValue = this->GetInputImage()->GetPixel(index);
+  const double currentPixelValue = this->GetValue(index);
+  const RegionEdgeCriterion criterion(m_Lower, m_Upper);
 
   typedef ConstNeighborhoodIterator< InputImageType > NeighborhoodIteratorType;
   typename NeighborhoodIteratorType::RadiusType radius;
@@ -109,6 +114,10 @@ RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
 
   //std::cout << "Loop for index: " << index << std::endl;
 
+  // Closest region neighbor, reported if the pixel is rejected
+  bool foundRegionNeighbor = false;
+  double closestDifference = 0.0;
+
   for (unsigned int i = 0; i < it.Size(); ++i)
     {
     if(RegionSize == 0)
@@ -144,19 +153,63 @@ RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
       continue;
       }
 
+    const double neighborValue = m_TileCache ? m_TileCache->GetValue(OutputImagePixelIndex)
+                                             : static_cast<double>(CurrentNeighbor);
+
     // if value falls in the acceptable range
-    if( (CurrentNeighbor - m_Lower) <= currentPixelValue &&
-        (CurrentNeighbor + m_Upper) >= currentPixelValue )
+    if( criterion.Accepts(currentPixelValue - neighborValue) )
       {
       //std::cout << "Add pixel " << index << " to region!" << std::endl << std::endl;
       return true;
       }
+
+    if(m_RejectionContainer)
+      {
+      const double difference = currentPixelValue - neighborValue;
+      if(!foundRegionNeighbor || std::fabs(difference) < std::fabs(closestDifference))
+        {
+        closestDifference = difference;
+        foundRegionNeighbor = true;
+        }
+      }
+    }
+
+  if(m_RejectionContainer && foundRegionNeighbor)
+    {
+    RejectionType rejection;
+    rejection.m_Index = index;
+    rejection.m_Difference = closestDifference;
+    m_RejectionContainer->push_back(rejection);
     }
 
   //std::cout << "Do NOT add pixel " << index << " to region!" << std::endl << std::endl;
   return false;
 }
 
+template <class TInputImage, class TOutputImageType, class TCoordRep>
+bool
+RegionEdgeFunction<TInputImage,TOutputImageType, TCoordRep>
+::EvaluateFromParent( const IndexType & parent, double parentValue,
+                      const OffsetType & offset, double & difference ) const
+{
+  const IndexType index = parent + offset;
+  difference = this->GetValue(index) - parentValue;
+
+  if( RegionEdgeCriterion(m_Lower, m_Upper).Accepts(difference) )
+    {
+    return true;
+    }
+
+  if(m_RejectionContainer)
+    {
+    RejectionType rejection;
+    rejection.m_Index = index;
+    rejection.m_Difference = difference;
+    m_RejectionContainer->push_back(rejection);
+    }
+  return false;
+}
+
 } // end namespace itk
 
 #endif
@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeGaussianKernel.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeGaussianKernel_h
+#define __itkRegionEdgeGaussianKernel_h
+
+#include "itkRegionEdgePreprocessingKernel.h"
+#include "itkObjectFactory.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeGaussianKernel
+ * \brief Gaussian weighted average of the neighborhood of a pixel
+ *
+ * Sigma is in physical units. The weights are sampled from the Gaussian
+ * up to three Sigma away in every dimension and normalized over the
+ * neighbors inside the image, so the border is not darkened.
+ *
+ * The whole neighborhood is read for every pixel, which is only cheaper
+ * than a separable full image filter when few pixels are evaluated.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TInputImage>
+class ITK_EXPORT RegionEdgeGaussianKernel : public RegionEdgePreprocessingKernel<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgeGaussianKernel                   Self;
+  typedef RegionEdgePreprocessingKernel<TInputImage> Superclass;
+  typedef SmartPointer<Self>                         Pointer;
+  typedef SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgeGaussianKernel, RegionEdgePreprocessingKernel);
+
+  typedef typename Superclass::InputImageType InputImageType;
+  typedef typename Superclass::IndexType      IndexType;
+
+  /** Set/Get the standard deviation of the Gaussian, in physical units.
+   * The default is 1. */
+  itkSetMacro(Sigma, double);
+  itkGetConstMacro(Sigma, double);
+
+  virtual void Initialize( const InputImageType * image );
+
+  virtual double Evaluate( const InputImageType * image, const IndexType & index ) const;
+
+protected:
+  RegionEdgeGaussianKernel();
+  ~RegionEdgeGaussianKernel() {}
+  void PrintSelf(std::ostream& os, Indent indent) const;
+
+private:
+  RegionEdgeGaussianKernel(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  double m_Sigma;
+
+  // Weights of the offsets -radius to radius, per dimension
+  std::vector<double> m_Weights[InputImageType::ImageDimension];
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeGaussianKernel.hxx"
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeGaussianKernel.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeGaussianKernel_txx
+#define __itkRegionEdgeGaussianKernel_txx
+
+#include "itkRegionEdgeGaussianKernel.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <cmath>
+
+namespace itk
+{
+
+template <class TInputImage>
+RegionEdgeGaussianKernel<TInputImage>
+::RegionEdgeGaussianKernel()
+{
+  m_Sigma = 1.0;
+}
+
+template <class TInputImage>
+void
+RegionEdgeGaussianKernel<TInputImage>
+::Initialize( const InputImageType * image )
+{
+  for(unsigned int d = 0; d < InputImageType::ImageDimension; ++d)
+    {
+    const double sigma = m_Sigma / image->GetSpacing()[d];
+    const int radius = static_cast<int>(std::ceil(3.0 * sigma));
+
+    m_Weights[d].resize(2 * radius + 1);
+    for(int i = -radius; i <= radius; ++i)
+      {
+      m_Weights[d][i + radius] = sigma > 0.0 ? std::exp(-0.5 * i * i / (sigma * sigma)) : 1.0;
+      }
+    }
+}
+
+template <class TInputImage>
+double
+RegionEdgeGaussianKernel<TInputImage>
+::Evaluate( const InputImageType * image, const IndexType & index ) const
+{
+  typename InputImageType::RegionType neighborhood;
+  IndexValueType radius[InputImageType::ImageDimension];
+  for(unsigned int d = 0; d < InputImageType::ImageDimension; ++d)
+    {
+    radius[d] = static_cast<IndexValueType>(m_Weights[d].size() / 2);
+    neighborhood.SetIndex(d, index[d] - radius[d]);
+    neighborhood.SetSize(d, m_Weights[d].size());
+    }
+  neighborhood.Crop(image->GetBufferedRegion());
+
+  double sum = 0.0;
+  double weightSum = 0.0;
+  ImageRegionConstIteratorWithIndex<InputImageType> it(image, neighborhood);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    double weight = 1.0;
+    for(unsigned int d = 0; d < InputImageType::ImageDimension; ++d)
+      {
+      weight *= m_Weights[d][it.GetIndex()[d] - index[d] + radius[d]];
+      }
+    sum += weight * static_cast<double>(it.Get());
+    weightSum += weight;
+    }
+
+  return sum / weightSum;
+}
+
+template <class TInputImage>
+void
+RegionEdgeGaussianKernel<TInputImage>
+::PrintSelf(std::ostream& os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Sigma: " << m_Sigma << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeGrowthRecord.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeGrowthRecord_h
+#define __itkRegionEdgeGrowthRecord_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIndex.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeGrowthRecord
+ * \brief Pixels accepted into a growing region, readable while it grows
+ *
+ * The growing thread appends every accepted pixel; any other thread can
+ * take a Snapshot at any time. A snapshot is a consistent view of the
+ * first pixels accepted so far: it shares the storage of the record
+ * instead of copying it, and stays valid after the record is reset or
+ * destroyed.
+ *
+ * Pixels are stored in fixed size chunks that never move. Appending only
+ * locks when a chunk is full or on Publish(), so the growth itself is
+ * not slowed down by readers.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <unsigned int VDimension>
+class ITK_EXPORT RegionEdgeGrowthRecord : public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgeGrowthRecord    Self;
+  typedef Object                    Superclass;
+  typedef SmartPointer<Self>        Pointer;
+  typedef SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgeGrowthRecord, Object);
+
+  typedef Index<VDimension> IndexType;
+
+  /** Number of pixels per chunk of storage. */
+  itkStaticConstMacro(ChunkSize, unsigned int, 4096);
+
+protected:
+  // Storage of one run of the growth, shared with the snapshots taken of it
+  class Storage : public LightObject
+  {
+  public:
+    typedef Storage                  Self;
+    typedef SmartPointer<const Self> ConstPointer;
+    typedef SmartPointer<Self>       Pointer;
+    itkSimpleNewMacro(Self);
+
+    std::vector<IndexType *> m_Chunks;
+
+  protected:
+    Storage() {}
+    ~Storage()
+      {
+      for(unsigned int i = 0; i < m_Chunks.size(); ++i)
+        {
+        delete [] m_Chunks[i];
+        }
+      }
+
+  private:
+    Storage(const Self&); //purposely not implemented
+    void operator=(const Self&); //purposely not implemented
+  };
+
+public:
+  /** \class Snapshot
+   * Consistent view of the pixels accepted up to the time it was taken. */
+  class Snapshot
+  {
+  public:
+    Snapshot() : m_NumberOfPixels(0) {}
+
+    /** Number of pixels accepted when the snapshot was taken. */
+    SizeValueType GetNumberOfPixels() const { return m_NumberOfPixels; }
+
+    /** The i-th accepted pixel, 0 <= i < GetNumberOfPixels(). */
+    const IndexType & GetPixel(SizeValueType i) const
+      {
+      return m_Chunks[i / ChunkSize][i % ChunkSize];
+      }
+
+  private:
+    friend class RegionEdgeGrowthRecord;
+
+    typename Storage::ConstPointer  m_Storage;
+    std::vector<const IndexType *>  m_Chunks;
+    SizeValueType                   m_NumberOfPixels;
+  };
+
+  /** Start an empty record. Called by the growing thread before growth. */
+  void Initialize();
+
+  /** Append an accepted pixel. Called by the growing thread only. */
+  void Append(const IndexType & index)
+    {
+    m_CurrentChunk[m_CurrentChunkFill] = index;
+    ++m_NumberOfPixels;
+    if(++m_CurrentChunkFill == ChunkSize)
+      {
+      this->AddChunk();
+      }
+    }
+
+  /** Make every pixel appended so far visible to snapshots. Called by the
+   * growing thread only. */
+  void Publish();
+
+  /** Take a snapshot. Can be called from any thread. */
+  Snapshot GetSnapshot() const;
+
+protected:
+  RegionEdgeGrowthRecord();
+  ~RegionEdgeGrowthRecord() {}
+  void PrintSelf(std::ostream& os, Indent indent) const;
+
+private:
+  RegionEdgeGrowthRecord(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  // Start a new chunk and publish the full one
+  void AddChunk();
+
+  // Written by the growing thread only
+  IndexType *     m_CurrentChunk;
+  unsigned int    m_CurrentChunkFill;
+  SizeValueType   m_NumberOfPixels;
+
+  // Shared with the readers, guarded by m_Lock
+  typename Storage::Pointer   m_Storage;
+  SizeValueType               m_NumberOfPublishedPixels;
+  mutable SimpleFastMutexLock m_Lock;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeGrowthRecord.hxx"
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeGrowthRecord.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeGrowthRecord_txx
+#define __itkRegionEdgeGrowthRecord_txx
+
+#include "itkRegionEdgeGrowthRecord.h"
+#include "itkMutexLockHolder.h"
+
+namespace itk
+{
+
+template <unsigned int VDimension>
+RegionEdgeGrowthRecord<VDimension>
+::RegionEdgeGrowthRecord()
+{
+  m_CurrentChunk = 0;
+  m_CurrentChunkFill = 0;
+  m_NumberOfPixels = 0;
+  m_NumberOfPublishedPixels = 0;
+  this->Initialize();
+}
+
+template <unsigned int VDimension>
+void
+RegionEdgeGrowthRecord<VDimension>
+::Initialize()
+{
+  // Snapshots of the previous run keep its storage alive
+  typename Storage::Pointer storage = Storage::New();
+  m_CurrentChunk = new IndexType[ChunkSize];
+  storage->m_Chunks.push_back(m_CurrentChunk);
+  m_CurrentChunkFill = 0;
+  m_NumberOfPixels = 0;
+
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  m_Storage = storage;
+  m_NumberOfPublishedPixels = 0;
+}
+
+template <unsigned int VDimension>
+void
+RegionEdgeGrowthRecord<VDimension>
+::AddChunk()
+{
+  IndexType * chunk = new IndexType[ChunkSize];
+
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  m_Storage->m_Chunks.push_back(chunk);
+  m_NumberOfPublishedPixels = m_NumberOfPixels;
+  m_CurrentChunk = chunk;
+  m_CurrentChunkFill = 0;
+}
+
+template <unsigned int VDimension>
+void
+RegionEdgeGrowthRecord<VDimension>
+::Publish()
+{
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  m_NumberOfPublishedPixels = m_NumberOfPixels;
+}
+
+template <unsigned int VDimension>
+typename RegionEdgeGrowthRecord<VDimension>::Snapshot
+RegionEdgeGrowthRecord<VDimension>
+::GetSnapshot() const
+{
+  Snapshot snapshot;
+
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  snapshot.m_Storage = m_Storage.GetPointer();
+  snapshot.m_Chunks.assign(m_Storage->m_Chunks.begin(), m_Storage->m_Chunks.end());
+  snapshot.m_NumberOfPixels = m_NumberOfPublishedPixels;
+  return snapshot;
+}
+
+template <unsigned int VDimension>
+void
+RegionEdgeGrowthRecord<VDimension>
+::PrintSelf(std::ostream& os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  MutexLockHolder<SimpleFastMutexLock> holder(m_Lock);
+  os << indent << "NumberOfPublishedPixels: " << m_NumberOfPublishedPixels << std::endl;
+  os << indent << "NumberOfChunks: " << m_Storage->m_Chunks.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,79 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeMedianKernel.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeMedianKernel_h
+#define __itkRegionEdgeMedianKernel_h
+
+#include "itkRegionEdgePreprocessingKernel.h"
+#include "itkObjectFactory.h"
+#include "itkSize.h"
+
+namespace itk
+{
+
+/** \class RegionEdgeMedianKernel
+ * \brief Median of the neighborhood of a pixel
+ *
+ * The same value as MedianImageFilter with the same Radius, except at
+ * the image border, where only the neighbors inside the image are used
+ * and the upper median is taken when their number is even.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TInputImage>
+class ITK_EXPORT RegionEdgeMedianKernel : public RegionEdgePreprocessingKernel<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgeMedianKernel                     Self;
+  typedef RegionEdgePreprocessingKernel<TInputImage> Superclass;
+  typedef SmartPointer<Self>                         Pointer;
+  typedef SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgeMedianKernel, RegionEdgePreprocessingKernel);
+
+  typedef typename Superclass::InputImageType InputImageType;
+  typedef typename Superclass::IndexType      IndexType;
+  typedef typename InputImageType::SizeType   RadiusType;
+
+  /** Set/Get the radius of the neighborhood. The default is 1 in every
+   * dimension. */
+  itkSetMacro(Radius, RadiusType);
+  itkGetConstReferenceMacro(Radius, RadiusType);
+
+  virtual double Evaluate( const InputImageType * image, const IndexType & index ) const;
+
+protected:
+  RegionEdgeMedianKernel();
+  ~RegionEdgeMedianKernel() {}
+  void PrintSelf(std::ostream& os, Indent indent) const;
+
+private:
+  RegionEdgeMedianKernel(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  RadiusType m_Radius;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeMedianKernel.hxx"
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeMedianKernel.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeMedianKernel_txx
+#define __itkRegionEdgeMedianKernel_txx
+
+#include "itkRegionEdgeMedianKernel.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+
+template <class TInputImage>
+RegionEdgeMedianKernel<TInputImage>
+::RegionEdgeMedianKernel()
+{
+  m_Radius.Fill(1);
+}
+
+template <class TInputImage>
+double
+RegionEdgeMedianKernel<TInputImage>
+::Evaluate( const InputImageType * image, const IndexType & index ) const
+{
+  typename InputImageType::RegionType neighborhood;
+  for(unsigned int d = 0; d < InputImageType::ImageDimension; ++d)
+    {
+    neighborhood.SetIndex(d, index[d] - static_cast<IndexValueType>(m_Radius[d]));
+    neighborhood.SetSize(d, 2 * m_Radius[d] + 1);
+    }
+  neighborhood.Crop(image->GetBufferedRegion());
+
+  std::vector<double> values;
+  values.reserve(neighborhood.GetNumberOfPixels());
+  ImageRegionConstIterator<InputImageType> it(image, neighborhood);
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    values.push_back(static_cast<double>(it.Get()));
+    }
+
+  typename std::vector<double>::iterator median = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), median, values.end());
+  return *median;
+}
+
+template <class TInputImage>
+void
+RegionEdgeMedianKernel<TInputImage>
+::PrintSelf(std::ostream& os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Radius: " << m_Radius << std::endl;
+}
+
+} // end namespace itk
+
+#endif
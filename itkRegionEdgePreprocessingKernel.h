@@ -0,0 +1,72 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgePreprocessingKernel.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgePreprocessingKernel_h
+#define __itkRegionEdgePreprocessingKernel_h
+
+#include "itkObject.h"
+
+namespace itk
+{
+
+/** \class RegionEdgePreprocessingKernel
+ * \brief Per pixel preprocessing evaluated lazily during region growing
+ *
+ * A kernel computes the preprocessed value of a single pixel from the
+ * input image, for instance a smoothed or rescaled intensity.
+ * ConnectedRegionEdgeThresholdImageFilter evaluates it only at the
+ * pixels the growth reads, instead of preprocessing the whole image in a
+ * separate filter.
+ *
+ * Initialize() is called once per run, before any Evaluate(), to
+ * precompute whatever depends on the image but not on the pixel.
+ * Evaluate() must only read the image: it may be called for any pixel
+ * of the buffered region, in any order.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TInputImage>
+class ITK_EXPORT RegionEdgePreprocessingKernel : public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgePreprocessingKernel Self;
+  typedef Object                        Superclass;
+  typedef SmartPointer<Self>            Pointer;
+  typedef SmartPointer<const Self>      ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgePreprocessingKernel, Object);
+
+  typedef TInputImage                        InputImageType;
+  typedef typename InputImageType::IndexType IndexType;
+
+  /** Prepare for evaluations on image. */
+  virtual void Initialize( const InputImageType * ) {}
+
+  /** Preprocessed value of the pixel at index. */
+  virtual double Evaluate( const InputImageType * image, const IndexType & index ) const = 0;
+
+protected:
+  RegionEdgePreprocessingKernel() {}
+  ~RegionEdgePreprocessingKernel() {}
+
+private:
+  RegionEdgePreprocessingKernel(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+};
+
+} // end namespace itk
+
+#endif
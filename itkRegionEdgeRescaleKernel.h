@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeRescaleKernel.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeRescaleKernel_h
+#define __itkRegionEdgeRescaleKernel_h
+
+#include "itkRegionEdgePreprocessingKernel.h"
+#include "itkObjectFactory.h"
+
+namespace itk
+{
+
+/** \class RegionEdgeRescaleKernel
+ * \brief Linear rescaling of the value of a pixel
+ *
+ * Returns Value * Scale + Shift: the value is scaled first, then
+ * shifted. This differs from ShiftScaleImageFilter, which computes
+ * (Value + Shift) * Scale; use Shift * Scale here for the same result.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TInputImage>
+class ITK_EXPORT RegionEdgeRescaleKernel : public RegionEdgePreprocessingKernel<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef RegionEdgeRescaleKernel                    Self;
+  typedef RegionEdgePreprocessingKernel<TInputImage> Superclass;
+  typedef SmartPointer<Self>                         Pointer;
+  typedef SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RegionEdgeRescaleKernel, RegionEdgePreprocessingKernel);
+
+  typedef typename Superclass::InputImageType InputImageType;
+  typedef typename Superclass::IndexType      IndexType;
+
+  /** Set/Get the factor the values are multiplied by. The default is 1. */
+  itkSetMacro(Scale, double);
+  itkGetConstMacro(Scale, double);
+
+  /** Set/Get the value added after scaling. The default is 0. */
+  itkSetMacro(Shift, double);
+  itkGetConstMacro(Shift, double);
+
+  virtual double Evaluate( const InputImageType * image, const IndexType & index ) const
+    {
+    return static_cast<double>(image->GetPixel(index)) * m_Scale + m_Shift;
+    }
+
+protected:
+  RegionEdgeRescaleKernel() : m_Scale(1.0), m_Shift(0.0) {}
+  ~RegionEdgeRescaleKernel() {}
+  void PrintSelf(std::ostream& os, Indent indent) const
+    {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "Scale: " << m_Scale << std::endl;
+    os << indent << "Shift: " << m_Shift << std::endl;
+    }
+
+private:
+  RegionEdgeRescaleKernel(const Self&); //purposely not implemented
+  void operator=(const Self&); //purposely not implemented
+
+  double m_Scale;
+  double m_Shift;
+};
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeStatistics.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeStatistics_h
+#define __itkRegionEdgeStatistics_h
+
+#include "itkImage.h"
+#include "itkContinuousIndex.h"
+#include "itkNumericTraits.h"
+
+#include <ostream>
+
+namespace itk
+{
+
+/** \class RegionEdgeStatistics
+ * \brief Statistics of a grown region, accumulated one pixel at a time
+ *
+ * RegionEdgeStatistics keeps running sums of the pixels added to a
+ * region so that the pixel count, physical volume, intensity
+ * mean/minimum/maximum/variance, centroid and bounding box are available
+ * as soon as the growth is done, without another pass over the image.
+ *
+ * AddPixel() is called for every pixel accepted into the region.
+ * Finalize() converts the sums into the reported quantities using the
+ * geometry of the image the region was grown in.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TImage>
+class RegionEdgeStatistics
+{
+public:
+  typedef RegionEdgeStatistics Self;
+
+  typedef TImage                           ImageType;
+  typedef typename ImageType::PixelType    PixelType;
+  typedef typename ImageType::IndexType    IndexType;
+  typedef typename ImageType::SizeType     SizeType;
+  typedef typename ImageType::RegionType   RegionType;
+  typedef typename ImageType::PointType    PointType;
+  typedef typename NumericTraits<PixelType>::RealType RealType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TImage::ImageDimension);
+
+  typedef ContinuousIndex<double, itkGetStaticConstMacro(ImageDimension)> ContinuousIndexType;
+
+  RegionEdgeStatistics();
+
+  /** Reset all sums to the empty region. */
+  void Initialize();
+
+  /** Add a pixel that has just been accepted into the region. */
+  void AddPixel( const IndexType & index, const PixelType & value );
+
+  /** Compute the derived quantities. The image supplies the spacing and
+   * the index to physical space transform. */
+  void Finalize( const ImageType * image );
+
+  /** Number of pixels in the region. */
+  SizeValueType GetCount() const { return m_Count; }
+
+  /** Physical volume of the region (count times the pixel volume). */
+  double GetVolume() const { return m_Volume; }
+
+  /** Intensity statistics of the input pixels in the region. The
+   * variance is the unbiased estimate. */
+  PixelType GetMinimum() const { return m_Minimum; }
+  PixelType GetMaximum() const { return m_Maximum; }
+  RealType GetMean() const { return m_Mean; }
+  RealType GetVariance() const { return m_Variance; }
+  RealType GetSigma() const { return m_Sigma; }
+  RealType GetSum() const { return m_Sum; }
+
+  /** Centroid of the region in physical space. */
+  const PointType & GetCentroid() const { return m_Centroid; }
+
+  /** Smallest index region containing every pixel of the region. Empty
+   * when the region has no pixels. */
+  const RegionType & GetBoundingBox() const { return m_BoundingBox; }
+
+  bool operator==( const Self & other ) const;
+  bool operator!=( const Self & other ) const { return !( *this == other ); }
+
+  void Print( std::ostream & os ) const;
+
+private:
+  SizeValueType m_Count;
+  RealType      m_Sum;
+  RealType      m_SumOfSquares;
+  PixelType     m_Minimum;
+  PixelType     m_Maximum;
+  double        m_IndexSum[ImageDimension];
+  IndexType     m_LowerIndex;
+  IndexType     m_UpperIndex;
+
+  double        m_Volume;
+  RealType      m_Mean;
+  RealType      m_Variance;
+  RealType      m_Sigma;
+  PointType     m_Centroid;
+  RegionType    m_BoundingBox;
+};
+
+template <class TImage>
+std::ostream & operator<<( std::ostream & os, const RegionEdgeStatistics<TImage> & statistics )
+{
+  statistics.Print( os );
+  return os;
+}
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeStatistics.hxx"
+#endif
+
+#endif
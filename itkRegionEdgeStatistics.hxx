@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeStatistics.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeStatistics_txx
+#define __itkRegionEdgeStatistics_txx
+
+#include "itkRegionEdgeStatistics.h"
+
+#include <cmath>
+
+namespace itk
+{
+
+template <class TImage>
+RegionEdgeStatistics<TImage>
+::RegionEdgeStatistics()
+{
+  this->Initialize();
+}
+
+template <class TImage>
+void
+RegionEdgeStatistics<TImage>
+::Initialize()
+{
+  m_Count = 0;
+  m_Sum = NumericTraits<RealType>::Zero;
+  m_SumOfSquares = NumericTraits<RealType>::Zero;
+  m_Minimum = NumericTraits<PixelType>::max();
+  m_Maximum = NumericTraits<PixelType>::NonpositiveMin();
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    m_IndexSum[d] = 0.0;
+    }
+  m_LowerIndex.Fill( NumericTraits<IndexValueType>::max() );
+  m_UpperIndex.Fill( NumericTraits<IndexValueType>::NonpositiveMin() );
+
+  m_Volume = 0.0;
+  m_Mean = NumericTraits<RealType>::Zero;
+  m_Variance = NumericTraits<RealType>::Zero;
+  m_Sigma = NumericTraits<RealType>::Zero;
+  m_Centroid.Fill( 0.0 );
+
+  IndexType start;
+  start.Fill( 0 );
+  SizeType size;
+  size.Fill( 0 );
+  m_BoundingBox.SetIndex( start );
+  m_BoundingBox.SetSize( size );
+}
+
+template <class TImage>
+void
+RegionEdgeStatistics<TImage>
+::AddPixel( const IndexType & index, const PixelType & value )
+{
+  const RealType realValue = static_cast<RealType>( value );
+
+  ++m_Count;
+  m_Sum += realValue;
+  m_SumOfSquares += realValue * realValue;
+
+  if(value < m_Minimum)
+    {
+    m_Minimum = value;
+    }
+  if(value > m_Maximum)
+    {
+    m_Maximum = value;
+    }
+
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    m_IndexSum[d] += static_cast<double>( index[d] );
+    if(index[d] < m_LowerIndex[d])
+      {
+      m_LowerIndex[d] = index[d];
+      }
+    if(index[d] > m_UpperIndex[d])
+      {
+      m_UpperIndex[d] = index[d];
+      }
+    }
+}
+
+template <class TImage>
+void
+RegionEdgeStatistics<TImage>
+::Finalize( const ImageType * image )
+{
+  if(m_Count == 0)
+    {
+    return;
+    }
+
+  const double count = static_cast<double>( m_Count );
+
+  double pixelVolume = 1.0;
+  const typename ImageType::SpacingType & spacing = image->GetSpacing();
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    pixelVolume *= spacing[d];
+    }
+  m_Volume = count * pixelVolume;
+
+  m_Mean = m_Sum / count;
+  if(m_Count > 1)
+    {
+    // unbiased estimate, as in LabelStatisticsImageFilter
+    m_Variance = ( m_SumOfSquares - m_Sum * m_Sum / count ) / ( count - 1.0 );
+    if(m_Variance < NumericTraits<RealType>::Zero)
+      {
+      // guard against round off for constant regions
+      m_Variance = NumericTraits<RealType>::Zero;
+      }
+    }
+  m_Sigma = std::sqrt( static_cast<double>( m_Variance ) );
+
+  ContinuousIndexType centroidIndex;
+  IndexType start;
+  SizeType size;
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    centroidIndex[d] = m_IndexSum[d] / count;
+    start[d] = m_LowerIndex[d];
+    size[d] = static_cast<SizeValueType>( m_UpperIndex[d] - m_LowerIndex[d] + 1 );
+    }
+  image->TransformContinuousIndexToPhysicalPoint( centroidIndex, m_Centroid );
+  m_BoundingBox.SetIndex( start );
+  m_BoundingBox.SetSize( size );
+}
+
+template <class TImage>
+bool
+RegionEdgeStatistics<TImage>
+::operator==( const Self & other ) const
+{
+  return m_Count == other.m_Count &&
+         m_Sum == other.m_Sum &&
+         m_SumOfSquares == other.m_SumOfSquares &&
+         m_Minimum == other.m_Minimum &&
+         m_Maximum == other.m_Maximum &&
+         m_Volume == other.m_Volume &&
+         m_Centroid == other.m_Centroid &&
+         m_BoundingBox == other.m_BoundingBox;
+}
+
+template <class TImage>
+void
+RegionEdgeStatistics<TImage>
+::Print( std::ostream & os ) const
+{
+  os << "Count: " << m_Count
+     << " Volume: " << m_Volume
+     << " Mean: " << m_Mean
+     << " Minimum: " << static_cast<typename NumericTraits<PixelType>::PrintType>( m_Minimum )
+     << " Maximum: " << static_cast<typename NumericTraits<PixelType>::PrintType>( m_Maximum )
+     << " Variance: " << m_Variance
+     << " Centroid: " << m_Centroid
+     << " BoundingBox: " << m_BoundingBox.GetIndex() << " " << m_BoundingBox.GetSize();
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeTileCache.h,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeTileCache_h
+#define __itkRegionEdgeTileCache_h
+
+#include "itkRegionEdgePreprocessingKernel.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class RegionEdgeTileCache
+ * \brief Preprocessed values of an image, computed on first use
+ *
+ * GetValue() evaluates the kernel at a pixel the first time the pixel is
+ * asked for and returns the stored value afterwards. Values are stored
+ * in tiles of TileSize pixels along each dimension, and a tile is only
+ * allocated when one of its pixels is asked for. Memory and kernel
+ * evaluations therefore grow with the part of the image that is read,
+ * not with the image.
+ *
+ * The table of tiles itself is dense: one pointer per tile of the image.
+ *
+ * \ingroup RegionGrowingSegmentation
+ */
+template <class TInputImage>
+class RegionEdgeTileCache
+{
+public:
+  typedef TInputImage                           InputImageType;
+  typedef typename InputImageType::IndexType    IndexType;
+  typedef typename InputImageType::RegionType   RegionType;
+  typedef RegionEdgePreprocessingKernel<TInputImage> KernelType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  /** Number of pixels of a tile along each dimension. */
+  itkStaticConstMacro(TileSize, unsigned int, 8);
+
+  RegionEdgeTileCache();
+  ~RegionEdgeTileCache();
+
+  /** Start an empty cache of the values of kernel over the buffered
+   * region of image. Neither is owned by the cache; both must stay valid
+   * while it is used. */
+  void Initialize( const InputImageType * image, const KernelType * kernel );
+
+  /** Release every tile. */
+  void Clear();
+
+  /** Preprocessed value of the pixel at index, which must be inside the
+   * buffered region of the image. */
+  double GetValue( const IndexType & index );
+
+  /** Number of tiles allocated. */
+  SizeValueType GetNumberOfTiles() const { return m_NumberOfTiles; }
+
+  /** Number of pixels the kernel was evaluated at. */
+  SizeValueType GetNumberOfComputedValues() const { return m_NumberOfComputedValues; }
+
+private:
+  RegionEdgeTileCache(const RegionEdgeTileCache&); //purposely not implemented
+  void operator=(const RegionEdgeTileCache&); //purposely not implemented
+
+  struct TileType
+    {
+    std::vector<double>        m_Values;
+    std::vector<unsigned char> m_Computed;
+    };
+
+  const InputImageType * m_Image;
+  const KernelType *     m_Kernel;
+  IndexType              m_Origin;
+  SizeValueType          m_TileStrides[ImageDimension];
+  SizeValueType          m_PixelStrides[ImageDimension];
+  SizeValueType          m_PixelsPerTile;
+  std::vector<TileType *> m_Tiles;
+  SizeValueType          m_NumberOfTiles;
+  SizeValueType          m_NumberOfComputedValues;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRegionEdgeTileCache.hxx"
+#endif
+
+#endif
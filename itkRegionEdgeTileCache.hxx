@@ -0,0 +1,119 @@
+/*=========================================================================
+
+  Program:   Insight Segmentation & Registration Toolkit
+  Module:    $RCSfile: itkRegionEdgeTileCache.txx,v $
+  Language:  C++
+
+  Copyright (c) Insight Software Consortium. All rights reserved.
+  See ITKCopyright.txt or http://www.itk.org/HTML/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notices for more information.
+
+=========================================================================*/
+#ifndef __itkRegionEdgeTileCache_txx
+#define __itkRegionEdgeTileCache_txx
+
+#include "itkRegionEdgeTileCache.h"
+
+namespace itk
+{
+
+template <class TInputImage>
+RegionEdgeTileCache<TInputImage>
+::RegionEdgeTileCache()
+{
+  m_Image = 0;
+  m_Kernel = 0;
+  m_Origin.Fill(0);
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    m_TileStrides[d] = 0;
+    m_PixelStrides[d] = 0;
+    }
+  m_PixelsPerTile = 0;
+  m_NumberOfTiles = 0;
+  m_NumberOfComputedValues = 0;
+}
+
+template <class TInputImage>
+RegionEdgeTileCache<TInputImage>
+::~RegionEdgeTileCache()
+{
+  this->Clear();
+}
+
+template <class TInputImage>
+void
+RegionEdgeTileCache<TInputImage>
+::Initialize( const InputImageType * image, const KernelType * kernel )
+{
+  this->Clear();
+  m_Image = image;
+  m_Kernel = kernel;
+
+  const RegionType & region = image->GetBufferedRegion();
+  m_Origin = region.GetIndex();
+
+  SizeValueType numberOfTiles = 1;
+  m_PixelsPerTile = 1;
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    m_TileStrides[d] = numberOfTiles;
+    numberOfTiles *= (region.GetSize(d) + TileSize - 1) / TileSize;
+    m_PixelStrides[d] = m_PixelsPerTile;
+    m_PixelsPerTile *= TileSize;
+    }
+  m_Tiles.assign(numberOfTiles, static_cast<TileType *>(0));
+}
+
+template <class TInputImage>
+void
+RegionEdgeTileCache<TInputImage>
+::Clear()
+{
+  for(unsigned int i = 0; i < m_Tiles.size(); ++i)
+    {
+    delete m_Tiles[i];
+    }
+  m_Tiles.clear();
+  m_NumberOfTiles = 0;
+  m_NumberOfComputedValues = 0;
+}
+
+template <class TInputImage>
+double
+RegionEdgeTileCache<TInputImage>
+::GetValue( const IndexType & index )
+{
+  SizeValueType tile = 0;
+  SizeValueType pixel = 0;
+  for(unsigned int d = 0; d < ImageDimension; ++d)
+    {
+    const SizeValueType position = static_cast<SizeValueType>(index[d] - m_Origin[d]);
+    tile += (position / TileSize) * m_TileStrides[d];
+    pixel += (position % TileSize) * m_PixelStrides[d];
+    }
+
+  TileType *& tilePointer = m_Tiles[tile];
+  if(!tilePointer)
+    {
+    tilePointer = new TileType;
+    tilePointer->m_Values.resize(m_PixelsPerTile);
+    tilePointer->m_Computed.assign(m_PixelsPerTile, 0);
+    ++m_NumberOfTiles;
+    }
+
+  if(!tilePointer->m_Computed[pixel])
+    {
+    tilePointer->m_Values[pixel] = m_Kernel->Evaluate(m_Image, index);
+    tilePointer->m_Computed[pixel] = 1;
+    ++m_NumberOfComputedValues;
+    }
+  return tilePointer->m_Values[pixel];
+}
+
+} // end namespace itk
+
+#endif